@@ -0,0 +1,482 @@
+#include "../main/board.h"
+#include "../main/input.h"
+#include "../main/ttsolver.h"
+#include "../main/parallelTempering.h"
+#include "../main/tentMatcher.h"
+#include "../main/diversityMatrix.h"
+#include "../main/tilesSet.h"
+#include "../main/output.h"
+
+#include <chrono>
+#include <omp.h>
+#include <bitset>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Wall-clock benchmarks for the hot paths, run from the build directory
+ * Usage: ./run_benchmarks [test file]
+ * Results are printed as "name: value unit" lines so they can be diffed between commits.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Average time per generation of the genetic solver with a 100 board population
+ */
+static void benchGeneration(const std::string& filePath, size_t generations, TTSolver::Crossover kind, const char* kindName, bool steady = false) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    std::string path = filePath;
+    TTSolver solver(path.data(), 100, 50, board, 1, 0, 0, 13, 40);
+    solver.setCrossover(kind);
+    solver.setSteadyState(steady);
+
+    auto start = Clock::now();
+    size_t best = solver.runGenerations(generations);
+    double elapsed = secondsSince(start);
+
+    std::cout << "generation (" << filePath << ", 100 boards, " << kindName << (steady ? ", steady state" : "") << "): "
+              << elapsed * 1000.0 / generations << " ms/generation, " << solver.residentBoards() << " boards resident"
+              << " (best " << best << ")" << std::endl;
+}
+
+/**
+ * @brief Best violations after a fixed number of generations with uniform against violation-guided mutation
+ */
+static void benchTargetedMutation(const std::string& filePath, size_t generations) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    std::string path = filePath;
+
+    for (bool targeted : {false, true}) {
+        TTSolver solver(path.data(), 100, generations, board, 1, 0, 0, 13, 40);
+        solver.setTargetedMutation(targeted);
+        auto start = Clock::now();
+        size_t best = solver.runGenerations(generations);
+        double elapsed = secondsSince(start);
+        std::cout << "mutation (" << filePath << ", " << (targeted ? "targeted" : "uniform") << "): best " << best
+                  << " after " << generations << " generations, " << elapsed * 1000.0 / generations
+                  << " ms/generation" << std::endl;
+    }
+}
+
+/**
+ * @brief Boards bred per second by the island model against the barrier-per-generation loop, same 100 boards
+ */
+static void benchIslands(const std::string& filePath, size_t generations, size_t islands) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    std::string path = filePath;
+
+    TTSolver global(path.data(), 100, generations, board, 1, 0, 0, 13, 40);
+    auto start = Clock::now();
+    global.runGenerations(generations);
+    double globalRate = 100.0 * generations / secondsSince(start);
+
+    TTSolver island(path.data(), 100, generations, board, 1, 0, 0, 13, 40);
+    island.setIslands(islands);
+    start = Clock::now();
+    Board best = island.runIslands(generations);
+    double islandRate = 100.0 / islands * island.islandGenerations() / secondsSince(start);
+
+    std::cout << "islands (" << filePath << ", " << islands << " islands): " << islandRate << " boards/s, global "
+              << globalRate << " boards/s (best " << best.getViolations() << ")" << std::endl;
+}
+
+/**
+ * @brief Moves/s per replica as the ladder grows, flat numbers mean the exchange barrier and shared best scale
+ */
+static void benchTempering(const std::string& filePath, size_t movesPerReplica) {
+    Input input;
+    Board seed = TentMatcher(input.inputFromFile(filePath)).buildBoard();
+    std::string path = filePath;
+
+    // Doubling replica counts up to the thread count, which is always measured last.
+    size_t maxReplicas = static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+    std::vector<size_t> counts;
+    for (size_t replicas = 1; replicas < maxReplicas; replicas *= 2)
+        counts.push_back(replicas);
+    counts.push_back(maxReplicas);
+
+    for (size_t replicas : counts) {
+        ParallelTempering tempering(path.data(), seed, replicas, 0.05, 2.0, 1000.0, 3);
+        tempering.setMoveLimit(movesPerReplica);
+        auto start = Clock::now();
+        size_t best = tempering.temper();
+        double seconds = secondsSince(start);
+
+        size_t moves = 0;
+        for (size_t i = 0; i < replicas; i++)
+            moves += tempering.getReplica(i).getMoveCount();
+        std::cout << "tempering (" << filePath << ", " << replicas << " replicas): " << moves / seconds / replicas
+                  << " moves/s per replica, " << tempering.getExchangeAccepts() << "/" << tempering.getExchangeAttempts()
+                  << " swaps (best " << best << ")" << std::endl;
+    }
+}
+
+/**
+ * @brief Time to build the tree-tent matching and lay a seeded board from it
+ */
+static void benchMatching(const std::string& filePath) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+
+    auto start = Clock::now();
+    TentMatcher matcher(board);
+    double matchTime = secondsSince(start);
+    start = Clock::now();
+    Board seeded = matcher.buildBoard();
+    double buildTime = secondsSince(start);
+
+    std::cout << "matching (" << filePath << "): " << matchTime * 1000.0 << " ms match + " << buildTime * 1000.0
+              << " ms build, " << matcher.getMatchingSize() << " matched, violations " << board.getViolations()
+              << " -> " << seeded.getViolations() << std::endl;
+}
+
+/**
+ * @brief The line-vector parser Input used before the memory-mapped one, kept as the baseline for benchParsing
+ * Validation is left out, it only has to do the same reading and copying work.
+ */
+static Board legacyInputFromFile(const std::string& filePath) {
+    std::ifstream file(filePath);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(file, line))
+        lines.push_back(line);
+
+    size_t rows, columns, tempNum, numTrees = 0;
+    std::istringstream iss1(lines[0]);
+    iss1 >> rows >> columns;
+    std::vector<size_t> rowTents, columnTents;
+    std::istringstream iss2(lines[1]);
+    for (size_t i = 0; i < rows && iss2 >> tempNum; ++i)
+        rowTents.push_back(tempNum);
+    std::istringstream iss3(lines[2]);
+    for (size_t i = 0; i < columns && iss3 >> tempNum; ++i)
+        columnTents.push_back(tempNum);
+
+    std::vector<std::vector<Tile>> boardTiles;
+    for (size_t i = 0; i < rows; ++i) {
+        std::vector<Tile> tempVector;
+        for (size_t j = 0; j < columns; ++j) {
+            if (lines[i + 3][j] == 'T') {
+                tempVector.push_back(Tile(Type::TREE, i, j));
+                ++numTrees;
+            } else {
+                tempVector.push_back(Tile(Type::NONE, i, j));
+            }
+        }
+        boardTiles.push_back(tempVector);
+    }
+    return Board(rows, columns, rowTents, columnTents, boardTiles, numTrees);
+}
+
+/**
+ * @brief Load plus Board construction time of the current parser against the old line-vector one
+ */
+static void benchParsing(const std::string& filePath, size_t repetitions) {
+    Input input;
+    size_t checksum = 0;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        checksum += input.inputFromFile(filePath).getViolations();
+    double current = secondsSince(start) / repetitions;
+
+    // Construction alone, from the same flat cells the parser hands over
+    Board parsed = input.inputFromFile(filePath);
+    start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        checksum += Board(parsed.getNumRows(), parsed.getNumCols(), parsed.getRowTentNum(), parsed.getColTentNum(), parsed.getCells()).getViolations();
+    double construction = secondsSince(start) / repetitions;
+    checksum -= parsed.getViolations() * repetitions;
+
+    start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        checksum -= legacyInputFromFile(filePath).getViolations();
+    double legacy = secondsSince(start) / repetitions;
+
+    std::cout << "parsing (" << filePath << "): " << current * 1000.0 << " ms/load (" << (current - construction) * 1000.0
+              << " ms parse + " << construction * 1000.0 << " ms Board), line-vector baseline "
+              << legacy * 1000.0 << " ms/load" << (checksum != 0 ? " (boards differ!)" : "") << std::endl;
+}
+
+/**
+ * @brief One full-board crossover step: the word-parallel copyCellsFrom against the old per-tile getTile/setTile walk
+ * Both parents are matching seeds laid in different orders, so they share most cells like a converged population.
+ */
+static void benchCrossover(const std::string& filePath, size_t repetitions) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    TentMatcher matcher(board);
+    std::mt19937 gen(1), gen2(2);
+    Board parent1 = matcher.buildBoard(&gen);
+    Board parent2 = matcher.buildBoard(&gen2);
+    Board child = parent1;
+    size_t rows = board.getNumRows(), cols = board.getNumCols();
+
+    size_t changed = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++) {
+        child.cloneFrom(parent1);
+        changed = child.copyCellsFrom(parent2, 0, rows * cols);
+    }
+    double wordParallel = secondsSince(start) / repetitions;
+
+    start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++) {
+        child.cloneFrom(parent1);
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = 0; c < cols; c++) {
+                Tile p2Tile = parent2.getTile(r, c);
+                if (child.getTile(r, c).getType() != p2Tile.getType())
+                    child.setTile(p2Tile, gen);
+            }
+        }
+    }
+    double perTile = secondsSince(start) / repetitions;
+
+    child.cloneFrom(parent1);
+    start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        child.cloneFrom(parent1);
+    double cloneOnly = secondsSince(start) / repetitions;
+
+    std::cout << "crossover (" << filePath << ", " << changed << " differing cells): " << (wordParallel - cloneOnly) * 1000.0
+              << " ms word-parallel, " << (perTile - cloneOnly) * 1000.0 << " ms per-tile, plus "
+              << cloneOnly * 1000.0 << " ms cloneFrom" << std::endl;
+}
+
+/**
+ * @brief Hamming distance between two seeded boards, the per-pair cost of diversity scoring
+ */
+static void benchDiversity(const std::string& filePath, size_t repetitions) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    TentMatcher matcher(board);
+    std::mt19937 gen(1), gen2(2);
+    Board a = matcher.buildBoard(&gen);
+    Board b = matcher.buildBoard(&gen2);
+
+    size_t distance = 0;
+    auto start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        distance += a.hammingDistance(b);
+    double elapsed = secondsSince(start) / repetitions;
+
+    // Baseline: the fixed 250*400 bitset every board used to carry, returned by value before XOR-ing
+    auto fixedBits = std::make_unique<std::bitset<250 * 400>>(), fixedOther = std::make_unique<std::bitset<250 * 400>>();
+    for (size_t i = 0; i < a.getNumTiles(); i++) {
+        fixedBits->set(i, a.getBitBoard().test(i));
+        fixedOther->set(i, b.getBitBoard().test(i));
+    }
+    auto byValue = [&]() { return *fixedOther; };
+    size_t fixedRepetitions = std::max<size_t>(repetitions / 100, 1);
+    start = Clock::now();
+    for (size_t i = 0; i < fixedRepetitions; i++)
+        distance -= (*fixedBits ^ byValue()).count() * 100;
+    double fixed = secondsSince(start) / fixedRepetitions;
+
+    double bytes = 2.0 * a.getBitBoard().numWords() * sizeof(uint64_t);
+    std::cout << "diversity (" << filePath << "): " << elapsed * 1e9 << " ns/pair, " << bytes / elapsed / 1e9
+              << " GB/s, fixed bitset baseline " << fixed * 1e9 << " ns/pair" << (distance != 0 ? " (distances differ!)" : "") << std::endl;
+}
+
+/**
+ * @brief Full pairwise distance matrix of a seeded population, blocked against a plain pair-by-pair loop
+ */
+static void benchDiversityMatrix(const std::string& filePath, size_t populationSize, size_t repetitions) {
+    Input input;
+    Board board = input.inputFromFile(filePath);
+    TentMatcher matcher(board);
+    std::mt19937 gen(1);
+    std::vector<Board> population;
+    for (size_t i = 0; i < populationSize; i++)
+        population.push_back(matcher.buildBoard(&gen));
+
+    DiversityMatrix matrix;
+    auto start = Clock::now();
+    for (size_t i = 0; i < repetitions; i++)
+        matrix.compute(population);
+    double blocked = secondsSince(start) / repetitions;
+
+    // Baseline: every pair counted straight from the boards, one row of the matrix after another
+    size_t mismatches = 0;
+    start = Clock::now();
+    for (size_t r = 0; r < repetitions; r++) {
+        for (size_t i = 0; i < populationSize; i++) {
+            for (size_t j = i + 1; j < populationSize; j++)
+                mismatches += population[i].hammingDistance(population[j]) != matrix.distance(i, j);
+        }
+    }
+    double naive = secondsSince(start) / repetitions;
+
+    std::cout << "diversity matrix (" << filePath << ", " << populationSize << " boards): " << blocked * 1e3
+              << " ms blocked, " << naive * 1e3 << " ms pair by pair" << (mismatches != 0 ? " (distances differ!)" : "") << std::endl;
+}
+
+/**
+ * @brief The vector plus unordered_map TilesSet boards used before the sparse set, kept as the baseline for benchTilesSet
+ */
+class LegacyTilesSet {
+    public:
+    LegacyTilesSet(size_t, size_t) { tiles.reserve(250 * 400); }
+
+    bool insert(const Coord c) {
+        if (tileIndex.find(c) != tileIndex.end())
+            return false;
+        tiles.push_back(c);
+        tileIndex[c] = tiles.size() - 1;
+        return true;
+    }
+
+    bool remove(const Coord c) {
+        auto it = tileIndex.find(c);
+        if (it == tileIndex.end())
+            return false;
+        size_t idx = it->second;
+        Coord lastTile = tiles.back();
+        tiles[idx] = lastTile;
+        tileIndex[lastTile] = idx;
+        tiles.pop_back();
+        tileIndex.erase(it);
+        return true;
+    }
+
+    std::optional<Coord> getTileAtIndex(size_t index) const {
+        if (index >= tiles.size())
+            return std::nullopt;
+        return tiles[index];
+    }
+
+    bool contains(const Coord &c) const { return tileIndex.count(c) > 0; }
+    size_t size() const { return tiles.size(); }
+
+    private:
+    std::vector<Coord> tiles;
+    std::unordered_map<Coord, size_t> tileIndex;
+};
+
+/**
+ * @brief Open/tent set pair of a board: filling it, moving sampled cells between the two sets, and copying both
+ */
+template <typename Set>
+static void benchTileSets(const Board& board, const char* name, size_t moves, size_t copies) {
+    size_t rows = board.getNumRows(), cols = board.getNumCols();
+    std::mt19937 gen(5);
+
+    auto start = Clock::now();
+    Set open(rows, cols), tents(rows, cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (board.getType(r, c) == Type::NONE)
+                open.insert(Coord(r, c));
+        }
+    }
+    double fill = secondsSince(start);
+
+    // Same traffic as placing and deleting tents: sample a member, move it to the other set.
+    // Tents build up to a fifth of the open cells first, then placements and deletions alternate.
+    size_t target = open.size() / 5;
+    start = Clock::now();
+    for (size_t i = 0; i < moves; i++) {
+        bool place = tents.size() < target || (i & 1);
+        Set& from = place ? open : tents;
+        Set& to = place ? tents : open;
+        Coord coord = *from.getTileAtIndex(std::uniform_int_distribution<size_t>(0, from.size() - 1)(gen));
+        from.remove(coord);
+        to.insert(coord);
+    }
+    double move = secondsSince(start) / moves;
+
+    Set openCopy = open, tentCopy = tents;
+    start = Clock::now();
+    for (size_t i = 0; i < copies; i++) {
+        openCopy = open;
+        tentCopy = tents;
+    }
+    double copy = secondsSince(start) / copies;
+
+    std::cout << "tiles set (" << name << ", " << open.size() << " open, " << tents.size() << " tents): " << fill * 1e3 << " ms fill, "
+              << move * 1e9 << " ns/move, " << copy * 1e3 << " ms/copy" << std::endl;
+}
+
+/**
+ * @brief Time to write a seeded board as a solution file, the old ofstream writer against one formatted buffer
+ */
+static void benchWriter(const std::string& filePath, size_t repetitions) {
+    Input input;
+    Board board = TentMatcher(input.inputFromFile(filePath)).buildBoard();
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "bench_writer.out";
+
+    auto start = Clock::now();
+    for (size_t rep = 0; rep < repetitions; rep++) {
+        std::ofstream outFile(path);
+        const TilesSet &tentTiles = board.getTentTilesData();
+        outFile << board.getViolations() << "\n" << tentTiles.size() << "\n";
+        for (size_t i = 0; i < tentTiles.size(); i++) {
+            int row = tentTiles.getTileAtIndex(i).value().getRow();
+            int col = tentTiles.getTileAtIndex(i).value().getCol();
+            outFile << row + 1 << " " << col + 1 << " " << board.getDir(row, col) << std::endl;
+        }
+    }
+    double legacy = secondsSince(start) / repetitions;
+
+    std::string buffer;
+    start = Clock::now();
+    for (size_t rep = 0; rep < repetitions; rep++)
+        formatSolution(board, buffer);
+    double format = secondsSince(start) / repetitions;
+
+    start = Clock::now();
+    for (size_t rep = 0; rep < repetitions; rep++) {
+        formatSolution(board, buffer);
+        writeFileAtomic(path, buffer);
+    }
+    double atomic = secondsSince(start) / repetitions;
+    std::filesystem::remove(path);
+
+    std::cout << "writer (" << filePath << ", " << board.getTentTilesData().size() << " tents): ofstream+endl "
+              << legacy * 1000.0 << " ms, to_chars format " << format * 1000.0 << " ms, format+atomic write+sync "
+              << atomic * 1000.0 << " ms" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string filePath = argc > 1 ? argv[1] : "../tests/test15.test";
+
+    for (std::string parseFile : {"../tests/test15.test", "../tests/test16.test", "../tests/test17.test"})
+        benchParsing(parseFile, 20);
+    {
+        Input input;
+        Board board = input.inputFromFile(filePath);
+        benchTileSets<TilesSet>(board, "sparse set", 2000000, 50);
+        benchTileSets<LegacyTilesSet>(board, "unordered_map", 2000000, 50);
+    }
+    benchDiversity("../tests/test5.test", 10000000);
+    benchDiversity(filePath, 100000);
+    benchDiversityMatrix(filePath, 100, 20);
+    benchDiversityMatrix(filePath, 400, 3);
+    benchMatching(filePath);
+    benchWriter(filePath, 20);
+    benchCrossover(filePath, 20);
+    benchGeneration(filePath, 20, TTSolver::Crossover::ONE_POINT, "one-point");
+    benchGeneration(filePath, 20, TTSolver::Crossover::UNIFORM, "uniform");
+    benchGeneration(filePath, 20, TTSolver::Crossover::RECTANGLE, "rect");
+    benchGeneration(filePath, 20, TTSolver::Crossover::ONE_POINT, "one-point", true);
+    benchIslands(filePath, 20, std::max(omp_get_max_threads(), 2));
+    benchTargetedMutation(filePath, 50);
+    benchTempering(filePath, ParallelTempering::MOVES_PER_EXCHANGE * 25);
+
+    return 0;
+}
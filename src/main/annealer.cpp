@@ -0,0 +1,255 @@
+#include "annealer.h"
+#include "output.h"
+#include "stopSignal.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+Annealer::Annealer(char * filePath, const Board& board, double startTemperature, double endTemperature, double timeLimitSeconds, unsigned seed)
+    : filePath(filePath),
+      board(board),
+      bestBoard(board),
+      bestViolations(board.getViolations()),
+      startTemperature(startTemperature),
+      endTemperature(endTemperature),
+      timeLimitSeconds(timeLimitSeconds),
+      gen(seed)
+{
+    // Replaying up to a few moves per cell is still cheaper than copying the board once.
+    journalLimit = std::max<size_t>(board.getNumTiles() * 4, 1024);
+    journal.reserve(journalLimit + 1);
+    setTemperature(startTemperature);
+}
+
+/*
+////////////////////////////////////////////////////
+Move proposal and acceptance
+////////////////////////////////////////////////////
+*/
+
+void Annealer::setTemperature(double newTemperature) {
+    temperature = newTemperature;
+    acceptance[0] = 1.0;
+    for (int delta = 1; delta <= MAX_TABLE_DELTA; delta++)
+        acceptance[delta] = std::exp(-delta / temperature);
+}
+
+bool Annealer::accept(int delta) {
+    if (delta <= 0)
+        return true;
+    double probability = delta <= MAX_TABLE_DELTA ? acceptance[delta] : std::exp(-delta / temperature);
+    return unitDist(gen) < probability;
+}
+
+// Picks a random adjacent tree for a tent at "to" that would have no other tent once "from" is gone.
+static char pickFreeTree(const Board& board, Coord to, Coord from, bool fromIsTent, std::mt19937& gen) {
+    const std::vector<uint8_t>& treeCounts = board.getTreeTentCount();
+    size_t cols = board.getNumCols();
+    int r = to.getRow();
+    int c = to.getCol();
+
+    // The tree currently held by the moving tent still counts it, so discount that one tent.
+    int fromTree = -1;
+    if (fromIsTent) {
+        switch (board.getDir(from.getRow(), from.getCol())) {
+            case 'U': fromTree = (from.getRow() - 1) * cols + from.getCol(); break;
+            case 'D': fromTree = (from.getRow() + 1) * cols + from.getCol(); break;
+            case 'L': fromTree = from.getRow() * cols + from.getCol() - 1; break;
+            case 'R': fromTree = from.getRow() * cols + from.getCol() + 1; break;
+            default: break;
+        }
+    }
+
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    const char dirs[4] = {'U', 'D', 'L', 'R'};
+    char options[4];
+    int numOptions = 0;
+    for (int k = 0; k < 4; k++) {
+        int nr = r + dr[k], nc = c + dc[k];
+        if (nr < 0 || nc < 0 || nr >= (int)board.getNumRows() || nc >= (int)cols)
+            continue;
+        if (board.getType(nr, nc) != Type::TREE)
+            continue;
+        int tree = nr * cols + nc;
+        if (treeCounts[tree] - (tree == fromTree ? 1 : 0) == 0)
+            options[numOptions++] = dirs[k];
+    }
+    if (numOptions == 0)
+        return 'X';
+    return options[gen() % numOptions];
+}
+
+bool Annealer::step() {
+    moveCount++;
+
+    std::uniform_int_distribution<int> kindDist(0, 99);
+    int kind = kindDist(gen);
+    if (board.getTentTilesData().size() == 0)
+        kind = 0;
+
+    Move move;
+    ViolationDelta delta;
+
+    if (kind < 30) {
+        // Add a tent on a random open cell.
+        std::optional<Coord> open = board.randomOpenTile(gen);
+        if (!open)
+            return false;
+        char dir = pickFreeTree(board, *open, *open, false, gen);
+        move = Move{Move::ADD, *open, *open, dir};
+        delta = board.deltaAdd(*open, dir);
+    }
+    else if (kind < 50) {
+        // Remove a random tent.
+        Coord tent = *board.randomTent(gen);
+        move = Move{Move::REMOVE, tent, tent, 'X'};
+        delta = board.deltaRemove(tent);
+    }
+    else if (kind < 85) {
+        // Shift a random tent to an open cell within two steps of it.
+        Coord tent = *board.randomTent(gen);
+        std::uniform_int_distribution<int> offsetDist(-2, 2);
+        int r = tent.getRow() + offsetDist(gen);
+        int c = tent.getCol() + offsetDist(gen);
+        if (r < 0 || c < 0 || r >= (int)board.getNumRows() || c >= (int)board.getNumCols())
+            return false;
+        if (board.getType(r, c) != Type::NONE)
+            return false;
+        Coord to(r, c);
+        char dir = pickFreeTree(board, to, tent, true, gen);
+        move = Move{Move::MOVE, tent, to, dir};
+        delta = board.deltaMove(tent, to, dir);
+    }
+    else {
+        // Re-associate a random tent with another adjacent tree, or none.
+        Coord tent = *board.randomTent(gen);
+        const int dr[4] = {-1, 1, 0, 0};
+        const int dc[4] = {0, 0, -1, 1};
+        const char dirs[4] = {'U', 'D', 'L', 'R'};
+        int k = gen() % 5;
+        char dir = 'X';
+        if (k < 4) {
+            int r = tent.getRow() + dr[k], c = tent.getCol() + dc[k];
+            if (r >= 0 && c >= 0 && r < (int)board.getNumRows() && c < (int)board.getNumCols() && board.getType(r, c) == Type::TREE)
+                dir = dirs[k];
+        }
+        if (dir == board.getDir(tent.getRow(), tent.getCol()))
+            return false;
+        move = Move{Move::MOVE, tent, tent, dir};
+        delta = board.deltaMove(tent, tent, dir);
+    }
+
+    if (!accept(delta.total()))
+        return false;
+
+    commit(move);
+    return true;
+}
+
+/*
+////////////////////////////////////////////////////
+Committing moves and tracking the best board
+////////////////////////////////////////////////////
+*/
+
+void Annealer::applyMove(Board& target, const Move& move) const {
+    switch (move.kind) {
+        case Move::ADD: target.placeTent(move.to, move.dir); break;
+        case Move::REMOVE: target.deleteTent(move.from); break;
+        case Move::MOVE: target.moveTent(move.from, move.to, move.dir); break;
+    }
+}
+
+void Annealer::commit(const Move& move) {
+    applyMove(board, move);
+    acceptedCount++;
+
+    if (journalValid) {
+        journal.push_back(move);
+        if (journal.size() >= journalLimit) {
+            syncBest();
+            // Nothing left worth replaying, the next best will be cloned instead.
+            if (journal.size() >= journalLimit / 2) {
+                journal.clear();
+                journalValid = false;
+            }
+        }
+    }
+
+    if (board.getViolations() < bestViolations) {
+        bestViolations = board.getViolations();
+        if (journalValid) {
+            bestPos = journal.size();
+        } else {
+            bestBoard.cloneFrom(board);
+            journal.clear();
+            bestPos = 0;
+            journalValid = true;
+        }
+    }
+}
+
+void Annealer::syncBest() {
+    if (bestPos == 0)
+        return;
+    for (size_t i = 0; i < bestPos; i++)
+        applyMove(bestBoard, journal[i]);
+    journal.erase(journal.begin(), journal.begin() + bestPos);
+    bestPos = 0;
+}
+
+const Board& Annealer::getBestBoard() {
+    syncBest();
+    return bestBoard;
+}
+
+/*
+////////////////////////////////////////////////////
+Running and Output
+////////////////////////////////////////////////////
+*/
+
+void Annealer::run(size_t moves, double newTemperature) {
+    if (newTemperature != temperature)
+        setTemperature(newTemperature);
+    for (size_t i = 0; i < moves; i++)
+        step();
+}
+
+size_t Annealer::anneal() {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    elapsed = 0.0;
+
+    // Temperature is only recomputed between batches, reading the clock per move would dominate.
+    constexpr size_t BATCH = 4096;
+    size_t moves = 0;
+    while (bestViolations > 0) {
+        double progress = moveLimit > 0 ? static_cast<double>(moves) / moveLimit
+            : timeLimitSeconds > 0.0 ? elapsed / timeLimitSeconds
+            : std::min(static_cast<double>(moves) / UNTIMED_SCHEDULE_MOVES, 1.0);
+        size_t batch = moveLimit > 0 ? std::min(BATCH, moveLimit - moves) : BATCH;
+        run(batch, startTemperature * std::pow(endTemperature / startTemperature, progress));
+        moves += batch;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        // A move limit replaces the clock entirely, otherwise a time limit of 0 runs until stopped.
+        bool outOfBudget = moveLimit > 0 ? moves >= moveLimit : timeLimitSeconds > 0.0 && elapsed >= timeLimitSeconds;
+        if (outOfBudget || stopRequested())
+            break;
+    }
+    return bestViolations;
+}
+
+size_t Annealer::solve() {
+    anneal();
+
+    const Board& best = getBestBoard();
+    if (!quiet)
+        std::cout << "anneal: " << moveCount << " moves in " << elapsed << " s ("
+                  << static_cast<size_t>(moveCount / std::max(elapsed, 1e-9)) << " moves/s), best " << best.getViolations() << std::endl;
+
+    writeSolutionAsync(filePath, best);
+    return bestViolations;
+}
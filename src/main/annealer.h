@@ -0,0 +1,120 @@
+#pragma once
+
+#include "board.h"
+
+#include <vector>
+#include <random>
+
+/**
+ * @brief Single-board simulated annealing solver for the Tents and Trees problem
+ * Works directly on one Board with add/remove/move/re-associate moves that are scored through the
+ * Board::delta* family before being committed, so the hot loop never copies a board.
+ * The best board is kept up to date lazily by replaying a journal of accepted moves.
+ */
+class Annealer {
+    public:
+    /**
+     * @brief Construct a new Annealer object
+     * The temperature falls geometrically from startTemperature to endTemperature over timeLimitSeconds,
+     * or over the move limit when one is set. A time limit of 0 is unlimited, the schedule then runs over
+     * UNTIMED_SCHEDULE_MOVES moves and stays cold afterwards.
+     */
+    Annealer(char * filePath, const Board& board, double startTemperature, double endTemperature, double timeLimitSeconds, unsigned seed = std::random_device{}());
+
+    /**
+     * @brief Runs the full schedule until the time budget runs out or a perfect board is found, then writes the output
+     * @return best number of violations found
+     */
+    size_t solve();
+
+    /**
+     * @brief Runs the same schedule as solve without printing or writing anything
+     * @return best number of violations found
+     */
+    size_t anneal();
+
+    /**
+     * @brief Ends anneal after this many moves and paces the schedule by moves instead of the clock, 0 for no limit
+     * The time limit is ignored while a move limit is set, so a seeded run is reproducible; stop requests still apply.
+     */
+    void setMoveLimit(size_t moves) { moveLimit = moves; }
+
+    /**
+     * @brief Leaves out the summary line solve prints, for --quiet
+     */
+    void setQuiet(bool enabled) { quiet = enabled; }
+
+    /**
+     * @brief Attempts a fixed number of moves at a fixed temperature, the building block for multi-chain engines
+     */
+    void run(size_t moves, double temperature);
+
+    /**
+     * @brief Returns the best board seen so far, replaying any pending journal entries first
+     */
+    const Board& getBestBoard();
+
+    size_t getViolations() const { return board.getViolations(); }
+    size_t getBestViolations() const { return bestViolations; }
+    size_t getMoveCount() const { return moveCount; }
+    size_t getAcceptedCount() const { return acceptedCount; }
+    double getTemperature() const { return temperature; }
+
+    private:
+
+    // A committed move, enough to replay it onto the best board
+    struct Move {
+        enum Kind : uint8_t { ADD, REMOVE, MOVE } kind;
+        Coord from;
+        Coord to;
+        char dir;
+    };
+
+    // Largest delta with a precomputed acceptance probability
+    static constexpr int MAX_TABLE_DELTA = 16;
+
+    // Length of the cooling schedule when neither a time nor a move limit gives one
+    static constexpr size_t UNTIMED_SCHEDULE_MOVES = 100000000;
+
+    char * filePath;
+    Board board;
+    Board bestBoard;
+    size_t bestViolations;
+
+    double startTemperature;
+    double endTemperature;
+    double timeLimitSeconds;
+    size_t moveLimit = 0;
+    bool quiet = false;
+    double temperature = 1.0;
+    double elapsed = 0.0;
+    double acceptance[MAX_TABLE_DELTA + 1];
+
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> unitDist{0.0, 1.0};
+
+    size_t moveCount = 0;
+    size_t acceptedCount = 0;
+
+    // Accepted moves since bestBoard was last synced, bestBoard + journal[0, bestPos) is the best board
+    std::vector<Move> journal;
+    size_t bestPos = 0;
+    bool journalValid = true;
+    size_t journalLimit;
+
+    /**
+     * @brief Proposes one random move and commits it with the Metropolis criterion
+     * @return true if the move was accepted
+     */
+    bool step();
+
+    /**
+     * @brief Sets the current temperature and rebuilds the acceptance table
+     */
+    void setTemperature(double);
+
+    bool accept(int delta);
+    void commit(const Move&);
+    void applyMove(Board&, const Move&) const;
+    void syncBest();
+};
@@ -0,0 +1,141 @@
+#include "batchScheduler.h"
+#include "input.h"
+#include "stopSignal.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <omp.h>
+
+BatchScheduler::BatchScheduler(const std::vector<std::string>& inputPaths, double budgetSeconds, double sliceSeconds, size_t threads)
+    : budgetSeconds(budgetSeconds), sliceSeconds(std::max(sliceSeconds, 0.0)), threads(std::max<size_t>(threads, 1)) {
+
+    std::vector<std::unique_ptr<Board>> boards(inputPaths.size());
+    std::vector<std::string> errors(inputPaths.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < inputPaths.size(); i++) {
+        try {
+            Input input;
+            boards[i] = std::make_unique<Board>(input.inputFromFile(inputPaths[i]));
+        } catch (const std::exception& error) {
+            errors[i] = error.what();
+        }
+    }
+
+    instances.reserve(inputPaths.size());
+    for (size_t i = 0; i < inputPaths.size(); i++) {
+        if (boards[i])
+            instances.emplace_back(inputPaths[i], std::move(*boards[i]));
+        else
+            std::cerr << "Skipping " << inputPaths[i] << ": " << errors[i] << std::endl;
+    }
+}
+
+std::vector<std::string> BatchScheduler::collectInputs(const std::vector<std::string>& paths) {
+    std::vector<std::string> inputs;
+    for (const std::string& path : paths) {
+        if (!std::filesystem::is_directory(path)) {
+            inputs.push_back(path);
+            continue;
+        }
+        std::vector<std::string> found;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(path)) {
+            std::filesystem::path extension = entry.path().extension();
+            if (entry.is_regular_file() && (extension == ".test" || extension == ".txt"))
+                found.push_back(entry.path().string());
+        }
+        std::sort(found.begin(), found.end());
+        inputs.insert(inputs.end(), found.begin(), found.end());
+    }
+    return inputs;
+}
+
+size_t BatchScheduler::pick(double elapsed) const {
+    size_t unsolved = 0;
+    for (const Instance& instance : instances)
+        unsolved += instance.solved ? 0 : 1;
+
+    size_t best = instances.size();
+    for (size_t i = 0; i < instances.size(); i++) {
+        const Instance& instance = instances[i];
+        if (instance.solved || instance.running)
+            continue;
+        // Far behind its fair share of the time used so far, it goes first whatever its rate.
+        if (instance.seconds < elapsed / (4.0 * static_cast<double>(unsolved)))
+            return i;
+        if (best == instances.size() || instance.rate > instances[best].rate
+            || (instance.rate == instances[best].rate && instance.seconds < instances[best].seconds))
+            best = i;
+    }
+    return best;
+}
+
+void BatchScheduler::run(const RoundFunction& round) {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    auto elapsedSince = [start]() { return std::chrono::duration<double>(Clock::now() - start).count(); };
+
+    size_t workers = std::min(threads, instances.size());
+    int threadsPerWorker = static_cast<int>(std::max<size_t>(threads / std::max<size_t>(workers, 1), 1));
+
+    auto work = [&]() {
+        // Per thread setting, every solver this worker runs sees its share as omp_get_max_threads()
+        omp_set_num_threads(threadsPerWorker);
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            double elapsed = elapsedSince();
+            bool outOfTime = budgetSeconds > 0.0 && elapsed >= budgetSeconds;
+            bool allSolved = std::all_of(instances.begin(), instances.end(), [](const Instance& i) { return i.solved; });
+            if (outOfTime || allSolved || stopRequested())
+                break;
+
+            size_t next = pick(elapsed);
+            if (next == instances.size()) {
+                // Everything left is running on other workers, a finished round may free one up.
+                idle.wait_for(lock, std::chrono::milliseconds(100));
+                continue;
+            }
+
+            Instance& instance = instances[next];
+            instance.running = true;
+            // A slice of 0 is unlimited, the round then only gets cut by what is left of the budget.
+            double slice = sliceSeconds;
+            if (budgetSeconds > 0.0)
+                slice = sliceSeconds > 0.0 ? std::min(sliceSeconds, budgetSeconds - elapsed) : budgetSeconds - elapsed;
+            size_t before = instance.best.getViolations();
+            lock.unlock();
+
+            // Only this worker touches the instance while it runs, so the round reads it without the lock.
+            auto roundStart = Clock::now();
+            Round result = round(instance, slice);
+            double seconds = std::chrono::duration<double>(Clock::now() - roundStart).count();
+
+            lock.lock();
+            size_t after = result.best.getViolations();
+            double rate = after < before ? static_cast<double>(before - after) / std::max(seconds, 1e-3) : 0.0;
+            instance.rate = instance.rounds == 0 ? rate : 0.5 * instance.rate + 0.5 * rate;
+            if (after < before)
+                instance.best = std::move(result.best);
+            instance.solved = result.optimal || instance.best.getViolations() == 0;
+            instance.seconds += seconds;
+            instance.rounds++;
+            instance.running = false;
+            idle.notify_all();
+        }
+        idle.notify_all();
+    };
+
+    // The calling thread is one of the workers, its own thread count is put back afterwards.
+    int callerThreads = omp_get_max_threads();
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < workers; w++)
+        pool.emplace_back(work);
+    if (workers > 0)
+        work();
+    for (std::thread& worker : pool)
+        worker.join();
+    omp_set_num_threads(callerThreads);
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "board.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Shares a global wall-clock budget and a thread count between several inputs
+ * Each input is parsed once and solved in rounds of at most sliceSeconds. Worker threads take the next round
+ * of whichever idle input removed the most violations per second in its recent rounds, so inputs that are stuck
+ * or solved stop taking time from those still improving. Any input that falls under a quarter of its fair share
+ * of time goes first, which keeps a stalled input from starving completely.
+ * The OpenMP threads are split evenly between the workers, each solver round runs with its share.
+ */
+class BatchScheduler {
+    public:
+    /**
+     * @brief One input and everything the scheduler keeps about it between rounds
+     */
+    struct Instance {
+        Instance(std::string path, Board input) : path(std::move(path)), input(input), best(std::move(input)) {}
+
+        std::string path;
+        Board input;                 // Parsed once, reused by every round
+        Board best;                  // Best board any round has found, starts as the input
+        size_t rounds = 0;
+        double seconds = 0.0;        // Solver time spent on this input
+        double rate = std::numeric_limits<double>::infinity(); // Recent violations removed per second
+        bool solved = false;         // Zero violations or proven optimal, no more rounds
+        bool running = false;
+    };
+
+    /**
+     * @brief Outcome of one solver round
+     */
+    struct Round {
+        Board best;
+        bool optimal = false;        // No board of this input can do better
+    };
+
+    /**
+     * @brief Runs one round on an instance for about the given seconds; called from worker threads, several
+     * rounds run at once but never two on the same instance
+     */
+    using RoundFunction = std::function<Round(Instance&, double seconds)>;
+
+    /**
+     * @brief Parses every input up front, in parallel; inputs that fail to parse are reported and left out
+     * @param budgetSeconds total wall-clock time, 0 runs until every input is solved or a stop is requested
+     * @param sliceSeconds longest round, 0 lets every round run as long as its engine does
+     * @param threads threads shared by all rounds, also the most rounds that run at once
+     */
+    BatchScheduler(const std::vector<std::string>& inputPaths, double budgetSeconds, double sliceSeconds, size_t threads);
+
+    /**
+     * @brief Input files named by paths, with every .test and .txt file of a directory in name order
+     */
+    static std::vector<std::string> collectInputs(const std::vector<std::string>& paths);
+
+    /**
+     * @brief Runs rounds until the budget is spent, every input is solved or stopRequested()
+     */
+    void run(const RoundFunction& round);
+
+    const std::vector<Instance>& getInstances() const { return instances; }
+
+    private:
+    std::vector<Instance> instances;
+    double budgetSeconds;
+    double sliceSeconds;
+    size_t threads;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+
+    /**
+     * @brief Index of the idle unsolved instance that should run next, instances.size() if none; mutex held
+     */
+    size_t pick(double elapsed) const;
+};
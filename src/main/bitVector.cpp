@@ -0,0 +1,79 @@
+#include "bitVector.h"
+
+#include <bit>
+#include <immintrin.h>
+
+void BitVector::resize(size_t newBits) {
+    bits = newBits;
+    size_t lines = (newBits + 64 * WORDS_PER_LINE - 1) / (64 * WORDS_PER_LINE);
+    words.assign(lines * WORDS_PER_LINE, 0);
+}
+
+size_t BitVector::count() const {
+    size_t total = 0;
+    for (uint64_t word : words)
+        total += std::popcount(word);
+    return total;
+}
+
+/*
+////////////////////////////////////////////////////
+XOR-popcount kernels
+////////////////////////////////////////////////////
+*/
+
+size_t BitVector::xorPopcountScalar(const uint64_t* a, const uint64_t* b, size_t words) {
+    size_t total = 0;
+    for (size_t i = 0; i < words; i++)
+        total += std::popcount(a[i] ^ b[i]);
+    return total;
+}
+
+#if defined(__AVX2__)
+// Nibble lookup popcount (Mula), bytes are summed into 64-bit lanes with SAD every line
+size_t BitVector::xorPopcountAvx2(const uint64_t* a, const uint64_t* b, size_t words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < words; i += WORDS_PER_LINE) {
+        __m256i x0 = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                      _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i)));
+        __m256i x1 = _mm256_xor_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(a + i + 4)),
+                                      _mm256_load_si256(reinterpret_cast<const __m256i*>(b + i + 4)));
+        __m256i c0 = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(x0, lowMask)),
+                                     _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x0, 4), lowMask)));
+        __m256i c1 = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, _mm256_and_si256(x1, lowMask)),
+                                     _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(x1, 4), lowMask)));
+        // Each byte is at most 16 here, far from overflowing before the SAD
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(c0, c1), _mm256_setzero_si256()));
+    }
+
+    return _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+}
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+size_t BitVector::xorPopcountAvx512(const uint64_t* a, const uint64_t* b, size_t words) {
+    __m512i total = _mm512_setzero_si512();
+    for (size_t i = 0; i < words; i += WORDS_PER_LINE) {
+        __m512i x = _mm512_xor_si512(_mm512_load_si512(a + i), _mm512_load_si512(b + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(x));
+    }
+    // Summed from memory, GCC's _mm512_reduce_add_epi64 trips -Wuninitialized inside its own extract helper
+    alignas(64) uint64_t lanes[8];
+    _mm512_store_si512(lanes, total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+#endif
+
+size_t BitVector::xorPopcount(const uint64_t* a, const uint64_t* b, size_t words) {
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+    return xorPopcountAvx512(a, b, words);
+#elif defined(__AVX2__)
+    return xorPopcountAvx2(a, b, words);
+#else
+    return xorPopcountScalar(a, b, words);
+#endif
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Minimal allocator handing out storage aligned to Alignment bytes
+ */
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment))); }
+    void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, std::align_val_t(Alignment)); }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+/**
+ * @brief Runtime-sized bit set, one bit per board cell
+ * Storage is cache-line aligned and padded to whole 64-byte lines with zero bits, so the XOR-popcount kernels
+ * run over full lines with aligned loads and no tail. The widest kernel the build targets is picked at compile
+ * time (AVX-512 VPOPCNTDQ, then AVX2, then scalar popcount); the others stay callable for testing.
+ */
+class BitVector {
+    public:
+    static constexpr size_t WORDS_PER_LINE = 8;
+
+    BitVector() = default;
+    explicit BitVector(size_t bits) { resize(bits); }
+
+    /**
+     * @brief Resizes to bits and clears every bit
+     */
+    void resize(size_t bits);
+
+    void set(size_t i) { words[i >> 6] |= uint64_t(1) << (i & 63); }
+    void reset(size_t i) { words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+    bool test(size_t i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+
+    size_t size() const { return bits; }
+    size_t numWords() const { return words.size(); }
+    const uint64_t* data() const { return words.data(); }
+
+    /**
+     * @brief Number of set bits
+     */
+    size_t count() const;
+
+    /**
+     * @brief Number of positions where this and other differ, without copying either; both must have the same size
+     */
+    size_t hamming(const BitVector& other) const { return xorPopcount(words.data(), other.words.data(), words.size()); }
+
+    /**
+     * @brief popcount(a ^ b) over words 64-bit words, words a multiple of WORDS_PER_LINE and both arrays 64-byte aligned
+     */
+    static size_t xorPopcount(const uint64_t* a, const uint64_t* b, size_t words);
+    static size_t xorPopcountScalar(const uint64_t* a, const uint64_t* b, size_t words);
+#if defined(__AVX2__)
+    static size_t xorPopcountAvx2(const uint64_t* a, const uint64_t* b, size_t words);
+#endif
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+    static size_t xorPopcountAvx512(const uint64_t* a, const uint64_t* b, size_t words);
+#endif
+
+    private:
+    size_t bits = 0;
+    std::vector<uint64_t, AlignedAllocator<uint64_t, 64>> words;
+};
@@ -1,12 +1,13 @@
 #include "board.h"
 #include <cmath>
-#include <unordered_set>
 #include <cstdlib>
-#include <ctime>
 #include <iostream>
 #include <algorithm>
 #include <random>
 #include <iomanip>
+#include <bit>
+#include <cstring>
+#include <limits>
 
 /*
 /////////////////////////////////////////////////////////////////////////////
@@ -14,61 +15,143 @@ Helper Functions (Add more if needed)
 /////////////////////////////////////////////////////////////////////////////
 */
 
-// Get all adjacent tents from a given coord, roughly O( 8log(n) )
-std::unordered_set<Coord> Board::getAdjacentTents(const Coord &coord) const {
-    std::unordered_set<Coord> adj; 
+uint8_t Board::dirCodeOf(char dir) {
+    switch (dir) {
+        case 'U': return 1;
+        case 'D': return 2;
+        case 'L': return 3;
+        case 'R': return 4;
+        default: return 0;
+    }
+}
 
-    constexpr Coord DIRS[8] = {
-        Coord(-1, -1), Coord(-1, 0), Coord(-1, 1),
-        Coord(0, -1),                Coord(0, 1),
-        Coord(1, -1),  Coord(1, 0),  Coord(1, 1)
-    };
-    
-    for (const Coord& dir : DIRS) {
-        Coord adjacent(coord.getRow() + dir.getRow(), coord.getCol() + dir.getCol());
-        if (tentTiles.contains(adjacent))
-            adj.insert(std::move(adjacent));
+size_t Board::treeIndexFor(size_t r, size_t c, uint8_t dirCode) const {
+    switch (dirCode) {
+        case 1: return r > 0 ? (r - 1) * colCount + c : numTiles;
+        case 2: return r + 1 < rowCount ? (r + 1) * colCount + c : numTiles;
+        case 3: return c > 0 ? r * colCount + c - 1 : numTiles;
+        case 4: return c + 1 < colCount ? r * colCount + c + 1 : numTiles;
+        default: return numTiles;
     }
-    return adj;
 }
 
-// Update all tents if they need to. roughly O( 8log(n) + 64log(n) )
-void Board::updateTentAdjacencyForCoord(const Coord &coord) {
-    std::unordered_set<Coord> adj = getAdjacentTents(coord);
+// Tree or invalid-tent violation counts for a tent at coord taking treeIdx (numTiles for none).
+void Board::attachToTree(const Coord& coord, size_t treeIdx) {
+    if (treeIdx != numTiles) {
+        uint8_t oldCount = treeTentCount[treeIdx]++;
+        if (oldCount == 0) {
+            treeViolations--;    // Tree now valid
+            lonelyTrees.remove(Coord(treeIdx / colCount, treeIdx % colCount));
+        } else if (oldCount == 1)
+            treeViolations++;    // Now too many tents
+    } else {
+        lonelyTentViolations++; // Lonely tent (womp)
+        lonelyTents.insert(coord);
+    }
+}
 
-    // If there's still a tent at coord, update its violation status.
-    if (board[coord.getRow()][coord.getCol()].getType() == Type::TENT) {
-        bool prevStatus = tentAdjViolation[coord];
-        bool newStatus = !adj.empty();
-        if (prevStatus != newStatus) {
-            tentViolations += (newStatus ? 1 : -1);
-            tentAdjViolation[coord] = newStatus;
-        }
+// Mirror of attachToTree.
+void Board::detachFromTree(const Coord& coord, size_t treeIdx) {
+    if (treeIdx != numTiles) {
+        uint8_t oldCount = treeTentCount[treeIdx]--;
+        if (oldCount == 1) {
+            treeViolations++;   // Now 0 tents: violation appears.
+            lonelyTrees.insert(Coord(treeIdx / colCount, treeIdx % colCount));
+        } else if (oldCount == 2)
+            treeViolations--;   // Now exactly one: violation resolved.
     } else {
-        // If the coordinate was marked as violating, remove that violation before erasing.
-        if (tentAdjViolation.count(coord) && tentAdjViolation[coord] == true) {
-            tentViolations -= 1;
+        lonelyTentViolations--;
+        lonelyTents.remove(coord);
+    }
+}
+
+// Registers a tent and updates every counter it touches, O(1) over the 3x3 neighbourhood.
+void Board::insertTent(size_t r, size_t c, uint8_t dirCode) {
+    size_t idx = r * colCount + c;
+    Coord coord(r, c);
+
+    // A direction that does not point at a tree cannot be honoured, treat it as a lonely tent.
+    size_t treeIdx = treeIndexFor(r, c, dirCode);
+    if (treeIdx == numTiles || cellType(cells[treeIdx]) != Type::TREE) {
+        dirCode = 0;
+        treeIdx = numTiles;
+    }
+
+    cells[idx] = packCell(Type::TENT, dirCode);
+    openTiles.remove(coord);
+    tentTiles.insert(coord);
+    bitSetTent(coord);
+
+    updateRowAndColForTent(r, c, true);
+
+    // Update adjacent tents.
+    size_t rLo = r > 0 ? r - 1 : r, rHi = r + 1 < rowCount ? r + 1 : r;
+    size_t cLo = c > 0 ? c - 1 : c, cHi = c + 1 < colCount ? c + 1 : c;
+    for (size_t i = rLo; i <= rHi; i++) {
+        for (size_t j = cLo; j <= cHi; j++) {
+            size_t n = i * colCount + j;
+            if (n == idx)
+                continue;
+            // A neighbouring tent that had no neighbours is now violating.
+            if (adjTentCount[n]++ == 0 && cellType(cells[n]) == Type::TENT) {
+                tentViolations++;
+                touchingTents.insert(Coord(i, j));
+            }
         }
-        tentAdjViolation.erase(std::move(coord));
     }
+    if (adjTentCount[idx] > 0) {
+        tentViolations++;
+        touchingTents.insert(coord);
+    }
+
+    attachToTree(coord, treeIdx);
+
+    violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
+}
+
+// Unregisters a tent, the exact mirror of insertTent.
+void Board::eraseTent(size_t r, size_t c) {
+    size_t idx = r * colCount + c;
+    Coord coord(r, c);
+    uint8_t dirCode = cellDirCode(cells[idx]);
+
+    cells[idx] = packCell(Type::NONE, 0);
+    tentTiles.remove(coord);
+    openTiles.insert(coord);
+    bitClearTent(coord);
+
+    updateRowAndColForTent(r, c, false);
 
-    // Update each neighboring tent's violation status.
-    for (const Coord& neighbor : adj) {
-        std::unordered_set<Coord> neighborAdj = getAdjacentTents(neighbor);
-        bool prevNeighborStatus = tentAdjViolation[neighbor];
-        bool newNeighborStatus = !neighborAdj.empty();
-        if (prevNeighborStatus != newNeighborStatus) {
-            tentViolations += (newNeighborStatus ? 1 : -1);
-            tentAdjViolation[neighbor] = newNeighborStatus;
+    // Update tent adjacency.
+    if (adjTentCount[idx] > 0) {
+        tentViolations--;
+        touchingTents.remove(coord);
+    }
+    size_t rLo = r > 0 ? r - 1 : r, rHi = r + 1 < rowCount ? r + 1 : r;
+    size_t cLo = c > 0 ? c - 1 : c, cHi = c + 1 < colCount ? c + 1 : c;
+    for (size_t i = rLo; i <= rHi; i++) {
+        for (size_t j = cLo; j <= cHi; j++) {
+            size_t n = i * colCount + j;
+            if (n == idx)
+                continue;
+            // A neighbouring tent that only touched this one is no longer violating.
+            if (--adjTentCount[n] == 0 && cellType(cells[n]) == Type::TENT) {
+                tentViolations--;
+                touchingTents.remove(Coord(i, j));
+            }
         }
     }
+
+    detachFromTree(coord, treeIndexFor(r, c, dirCode));
+
+    violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
 }
 
 
 void Board::drawBoard() const {
-    size_t rows = board.size();
+    size_t rows = rowCount;
     if (rows == 0) return;
-    size_t cols = board[0].size();
+    size_t cols = colCount;
 
     // Print column numbers on top with a 4-space offset for row numbers.
     std::cout << "    ";
@@ -91,7 +174,7 @@ void Board::drawBoard() const {
         for (size_t j = 0; j < cols; j++) {
             char outputChar;
             // Determine which character to display based on the tile type.
-            switch (board[i][j].getType()) {
+            switch (getType(i, j)) {
                 case Type::NONE:
                     outputChar = '.';
                     break;
@@ -99,7 +182,7 @@ void Board::drawBoard() const {
                     outputChar = 'T';
                     break;
                 case Type::TENT: {
-                    char dir = board[i][j].getDir();
+                    char dir = getDir(i, j);
                     // Use lowercase 't' if the direction is 'X', otherwise use the direction character.
                     outputChar = (dir == 'X') ? 't' : dir;
                     break;
@@ -141,6 +224,15 @@ void Board::updateRowAndColForTent (const size_t r, const size_t c, const bool a
     int oldColViol = abs((int)(colTentNum[c] - oldColCount));
     int newColViol = abs((int)(colTentNum[c] - currentColTents[c]));
     colViolations += (newColViol - oldColViol);
+
+    if (currentRowTents[r] == rowTentNum[r])
+        offRows.remove(Coord(r, 0));
+    else
+        offRows.insert(Coord(r, 0));
+    if (currentColTents[c] == colTentNum[c])
+        offCols.remove(Coord(c, 0));
+    else
+        offCols.insert(Coord(c, 0));
 }
 
 /*
@@ -149,8 +241,7 @@ Actual functions
 /////////////////////////////////////////////////////////////////////////////
 */
 
-// O( n + m + n*m * (nlog(n) + 72log(n) ) if theres a shit load of tents lol.
-// theta( n + m + n*m * klog(n) ) probably.
+// O( n*m ), every tent is registered in O(1) against the dense neighbourhood arrays.
 Board::Board(
     size_t rowCount, 
     size_t colCount,
@@ -160,204 +251,167 @@ Board::Board(
     size_t numTrees
     ){
 
-    srand(time(NULL));
     this->rowCount = rowCount;
     this->colCount = colCount;
-    this->rowTentNum = rowTentNum;
-    this->colTentNum = colTentNum;
-    this->board = board;
+    this->rowTentNum = std::move(rowTentNum);
+    this->colTentNum = std::move(colTentNum);
     this->numTrees = numTrees;
-
-    currentRowTents.assign(rowCount, 0);
-    currentColTents.assign(colCount, 0);
-
-    rowViolations = 0;
-    colViolations = 0;
-    tentViolations = 0;
-    treeViolations = 0;
-    lonelyTentViolations = 0;
-    violations = 0;
+    resetCounters();
     
-    // parse through the whole board
+    // First pass lays down the trees so tents can find their associated tree
     for(size_t i = 0; i < rowCount; i++){
         for(size_t j = 0; j < colCount; j++){
             // If the current tile is a tree
             if (board[i][j].getType() == Type::TREE) {
-                treeTentCount[Coord(i, j)] = 0;
+                cells[i * colCount + j] = packCell(Type::TREE, 0);
                 // Tree starts at 0 tents, will be lonely for valentines...
                 treeViolations++;
+                lonelyTrees.insert(Coord(i, j));
             }
+        }
+    }
 
-            // If the current tile is a tent
+    // Second pass registers tents at their own coordinate, ignoring duplicates
+    for(size_t i = 0; i < rowCount; i++){
+        for(size_t j = 0; j < colCount; j++){
             if(board[i][j].getType() == Type::TENT){
                 Coord coord = board[i][j].getCoord();
-                bitSetTent(coord);
-                if (!tentTiles.contains(coord)) {
-                    tentTiles.insert(coord);
-                    currentRowTents[i]++;
-                    currentColTents[j]++;
-
-                    char dir = board[i][j].getDir(); // Check the direction of the tent
-                    if (dir != 'X') {
-                        // Update the associated tree’s count.
-                        Coord treeCoord = coord; // should be a shallow copy, but we aren't using the old coord anymore, so its fine.
-                        switch (dir) {
-                            case 'U': treeCoord.setRow(i - 1); break;
-                            case 'D': treeCoord.setRow(i + 1); break;
-                            case 'L': treeCoord.setCol(j - 1); break;
-                            case 'R': treeCoord.setCol(j + 1); break;
-                            default: break;
-                        }
-
-                        int oldCount = treeTentCount[treeCoord];
-                        treeTentCount[treeCoord] = oldCount + 1;
-                        if (oldCount == 0)
-                            treeViolations--;    // Tree now has exactly one tent (resolved violation)
-                        else if (oldCount == 1)
-                            treeViolations++;    // Tree now has too many tents
-                    } else {
-                        lonelyTentViolations++; // Lonely tent (womp)
-                    }
-
-                    // Check if this tent has any adjacent tent already.
-                    updateTentAdjacencyForCoord(coord);
-                }
-            }
-            if(board[i][j].getType() == Type::NONE){
-                openTiles.insert(board[i][j].getCoord());
+                size_t r = coord.getRow();
+                size_t c = coord.getCol();
+                if (cellType(cells[r * colCount + c]) == Type::NONE)
+                    insertTent(r, c, dirCodeOf(board[i][j].getDir()));
             }
         }
     }
 
-    // Compute row and column violations based on initial counts.
-    for (size_t i = 0; i < rowCount; i++) {
-        rowViolations += std::abs((int)rowTentNum[i] - (int)currentRowTents[i]);
-    }
-    for (size_t j = 0; j < colCount; j++) {
-        colViolations += std::abs((int)colTentNum[j] - (int)currentColTents[j]);
-    }
-    violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
-
+    registerOpenTiles();
 }
 
-Board::Board(const Board& other) {
-    rowCount = other.getNumRows();
-    colCount = other.getNumCols();
-    board = other.getBoard();
-    rowTentNum = other.getRowTentNum();
-    colTentNum = other.getColTentNum();
-    currentRowTents = other.getCurrentRowTents();
-    currentColTents = other.getCurrentColTents();
-    tentTiles = other.getTentTilesData();
-    tentAdjViolation = other.getTentAdjViolation();
-    treeTentCount = other.getTreeTentCount();
-    numTrees = other.getNumTrees();
-    rowViolations = other.getRowViolations();
-    colViolations = other.getColViolations();
-    tentViolations = other.getTentViolations();
-    treeViolations = other.getTreeViolations();
-    lonelyTentViolations = other.getLonelyTentViolations();
-    violations = other.getViolations();
-    numTiles = other.getNumTiles();
-    openTiles = other.getOpenTilesData();
-    bitBoard = other.getBitBoard();
-}
-
-Board& Board::operator=(const Board& other) {
-    if (this != &other) {
-        rowCount = other.getNumRows();
-        colCount = other.getNumCols();
-        board = other.getBoard();
-        rowTentNum = other.getRowTentNum();
-        colTentNum = other.getColTentNum();
-        currentRowTents = other.getCurrentRowTents();
-        currentColTents = other.getCurrentColTents();
-        tentTiles = other.getTentTilesData();
-        tentAdjViolation = other.getTentAdjViolation();
-        treeTentCount = other.getTreeTentCount();
-        numTrees = other.getNumTrees();
-        rowViolations = other.getRowViolations();
-        colViolations = other.getColViolations();
-        tentViolations = other.getTentViolations();
-        treeViolations = other.getTreeViolations();
-        lonelyTentViolations = other.getLonelyTentViolations();
-        violations = other.getViolations();
-        numTiles = other.getNumTiles();
-        openTiles = other.getOpenTilesData();
-        bitBoard = other.getBitBoard();
-    }
-    return *this;
-}
+Board::Board(
+    size_t rowCount,
+    size_t colCount,
+    std::vector<size_t> rowTentNum,
+    std::vector<size_t> colTentNum,
+    const std::vector<uint8_t>& packedCells
+    ){
 
-bool Board::placeTent(Tile& tile, std::mt19937& gen) {
-    int r = tile.getCoord().getRow();
-    int c = tile.getCoord().getCol();
+    this->rowCount = rowCount;
+    this->colCount = colCount;
+    this->rowTentNum = std::move(rowTentNum);
+    this->colTentNum = std::move(colTentNum);
+    numTrees = 0;
+    resetCounters();
+
+    // Trees go in first so every tent below finds its tree already in place
+    for (size_t i = 0; i < numTiles; i++) {
+        if (cellType(packedCells[i]) == Type::TREE) {
+            cells[i] = packCell(Type::TREE, 0);
+            numTrees++;
+            treeViolations++;
+            lonelyTrees.insert(Coord(i / colCount, i % colCount));
+        }
+    }
 
-    // Place tent
-    tile.setType(Type::TENT);
-    openTiles.remove(tile.getCoord());
-    bitSetTent(tile.getCoord());
+    for (size_t i = 0; i < numTiles; i++) {
+        if (cellType(packedCells[i]) == Type::TENT)
+            insertTent(i / colCount, i % colCount, cellDirCode(packedCells[i]));
+    }
 
-    // Update row counts.
-    updateRowAndColForTent(r, c, true);
+    registerOpenTiles();
+}
 
-    Coord newCoord(r, c);
-    tentTiles.insert(newCoord);
+void Board::resetCounters() {
+    numTiles = rowCount * colCount;
+
+    cells.assign(numTiles, packCell(Type::NONE, 0));
+    adjTentCount.assign(numTiles, 0);
+    treeTentCount.assign(numTiles, 0);
+    bitBoard.resize(numTiles);
+    openTiles.reset(rowCount, colCount);
+    tentTiles.reset(rowCount, colCount);
+    touchingTents.reset(rowCount, colCount);
+    lonelyTents.reset(rowCount, colCount);
+    lonelyTrees.reset(rowCount, colCount);
+    offRows.reset(rowCount, 1);
+    offCols.reset(colCount, 1);
+    currentRowTents.assign(rowCount, 0);
+    currentColTents.assign(colCount, 0);
 
-    // Update adjacent tents.
-    updateTentAdjacencyForCoord(newCoord);
+    // With no tents placed every row/col is short by its full target.
+    rowViolations = 0;
+    colViolations = 0;
+    for (size_t i = 0; i < rowCount; i++) {
+        rowViolations += rowTentNum[i];
+        if (rowTentNum[i] != 0)
+            offRows.insert(Coord(i, 0));
+    }
+    for (size_t j = 0; j < colCount; j++) {
+        colViolations += colTentNum[j];
+        if (colTentNum[j] != 0)
+            offCols.insert(Coord(j, 0));
+    }
+    tentViolations = 0;
+    treeViolations = 0;
+    lonelyTentViolations = 0;
+    violations = 0;
+}
 
-    // Choose an associated tree.
-    std::vector<Tile> treeTiles;
-    if (c - 1 >= 0 && board[r][c - 1].getType() == Type::TREE && (treeTentCount[board[r][c - 1].getCoord()] == 0))
-        treeTiles.push_back(board[r][c - 1]);
-    if (c + 1 < colCount && board[r][c + 1].getType() == Type::TREE && (treeTentCount[board[r][c + 1].getCoord()] == 0))
-        treeTiles.push_back(board[r][c + 1]);
-    if (r - 1 >= 0 && board[r - 1][c].getType() == Type::TREE && (treeTentCount[board[r - 1][c].getCoord()] == 0))
-        treeTiles.push_back(board[r - 1][c]);
-    if (r + 1 < rowCount && board[r + 1][c].getType() == Type::TREE && (treeTentCount[board[r + 1][c].getCoord()] == 0))
-        treeTiles.push_back(board[r + 1][c]);
+void Board::registerOpenTiles() {
+    for (size_t i = 0; i < rowCount; i++) {
+        for (size_t j = 0; j < colCount; j++) {
+            if (cellType(cells[i * colCount + j]) == Type::NONE)
+                openTiles.insert(Coord(i, j));
+        }
+    }
 
-    // Shuffle treeTiles to randomize the iteration order.
-    std::uniform_int_distribution<> dis(0, treeTiles.size() - 1);
-    Tile bestTree = treeTiles.empty() ? tile : treeTiles[0];
+    violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
+}
 
+void Board::cloneFrom(const Board& other) {
+    if (this == &other)
+        return;
+
+    rowCount = other.rowCount;
+    colCount = other.colCount;
+    numTiles = other.numTiles;
+    numTrees = other.numTrees;
+
+    // assign() only reallocates when the destination is too small.
+    cells.assign(other.cells.begin(), other.cells.end());
+    rowTentNum.assign(other.rowTentNum.begin(), other.rowTentNum.end());
+    colTentNum.assign(other.colTentNum.begin(), other.colTentNum.end());
+    currentRowTents.assign(other.currentRowTents.begin(), other.currentRowTents.end());
+    currentColTents.assign(other.currentColTents.begin(), other.currentColTents.end());
+    adjTentCount.assign(other.adjTentCount.begin(), other.adjTentCount.end());
+    treeTentCount.assign(other.treeTentCount.begin(), other.treeTentCount.end());
+
+    rowViolations = other.rowViolations;
+    colViolations = other.colViolations;
+    tentViolations = other.tentViolations;
+    treeViolations = other.treeViolations;
+    lonelyTentViolations = other.lonelyTentViolations;
+    violations = other.violations;
+
+    openTiles = other.openTiles;
+    tentTiles = other.tentTiles;
+    touchingTents = other.touchingTents;
+    lonelyTents = other.lonelyTents;
+    lonelyTrees = other.lonelyTrees;
+    offRows = other.offRows;
+    offCols = other.offCols;
+    bitBoard = other.bitBoard;
+}
 
-    
-    // If no tree found, mark tent as invalid.
-    if (treeTiles.empty()) {
-        tile.setDir('X');
-        lonelyTentViolations++;
-    } else {
-        bestTree = treeTiles[dis(gen)];
-        // Follow original logic:
-        // If bestTree is above, below, left, or right, set the direction accordingly.
-        // (For example, if bestTree is at (r-1, c), we set dir to 'L', etc.)
-        Coord assocTree;
-        if (bestTree.getCoord() == Coord(r, c - 1)){
-            tile.setDir('L');
-            assocTree = Coord(r, c - 1);
-        }else if (bestTree.getCoord() == Coord(r, c + 1)){
-            tile.setDir('R');
-            assocTree = Coord(r, c + 1);
-        }else if (bestTree.getCoord() == Coord(r - 1, c)){
-            tile.setDir('U');
-            assocTree = Coord(r - 1, c);
-        }else if (bestTree.getCoord() == Coord(r + 1, c)){
-            tile.setDir('D');
-            assocTree = Coord(r + 1, c);
-        }
+bool Board::placeTent(Tile& tile, std::mt19937& gen) {
+    size_t r = tile.getCoord().getRow();
+    size_t c = tile.getCoord().getCol();
 
-        // Update tree tent count.
-        int oldCount = treeTentCount[assocTree];
-        treeTentCount[assocTree] = oldCount + 1;
-        if (oldCount == 0)
-            treeViolations--;    // Tree now valid
-        else if (oldCount == 1)
-            treeViolations++;    // Now too many tents
-    }
-    // Update overall violation count.
-    violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
+    // Choose an associated tree among the adjacent trees that have no tent yet, 'X' if there is none.
+    char dir = chooseTreeDir(tile.getCoord(), gen);
+
+    insertTent(r, c, dirCodeOf(dir));
+    tile.setType(Type::TENT);
+    tile.setDir(dir);
 
     return true;
 }
@@ -370,7 +424,8 @@ bool Board::addTent(std::mt19937 &gen) {
     std::uniform_int_distribution<int> dist(0, openTiles.size() - 1);
     std::optional<Coord> coord = openTiles.getTileAtIndex(dist(gen));
     if (coord != std::nullopt) {
-        if (placeTent(board[coord.value().getRow()][coord.value().getCol()], gen))
+        Tile tile = getTile(coord.value().getRow(), coord.value().getCol());
+        if (placeTent(tile, gen))
             return true;
     }
 
@@ -394,57 +449,462 @@ bool Board::removeTent(std::mt19937 &gen) {
 
 bool Board::deleteTent(Coord coord) {
 
-    int r = coord.getRow();
-    int c = coord.getCol();
+    eraseTent(coord.getRow(), coord.getCol());
 
-    tentTiles.remove(coord);
-    openTiles.insert(coord);
-    bitClearTent(coord);
+    return true;
 
-    board[r][c].setType(Type::NONE);
+}
 
-    // Update row counts.
-    updateRowAndColForTent(r, c, false);
+bool Board::moveTent(std::mt19937 &gen) {
+    if(removeTent(gen)){
+        if(addTent(gen))
+            return true;
+    }
+    return false;
+}
 
-    // Update tent adjacency.
-    updateTentAdjacencyForCoord(coord);
-
-    // Update tree or invalid-tent violation counts.
-    char dirChar = board[r][c].getDir();
-    if (dirChar != 'X') {
-        Coord assocTree;
-        switch (dirChar) {
-            case 'L': assocTree = Coord(r, c - 1); break;
-            case 'R': assocTree = Coord(r, c + 1); break;
-            case 'U': assocTree = Coord(r - 1, c); break;
-            case 'D': assocTree = Coord(r + 1, c); break;
-            default: break;
+
+bool Board::placeTent(Coord coord, char dir) {
+    size_t r = coord.getRow();
+    size_t c = coord.getCol();
+    if (cellType(cells[r * colCount + c]) != Type::NONE)
+        return false;
+
+    insertTent(r, c, dirCodeOf(dir));
+    return true;
+}
+
+bool Board::moveTent(Coord from, Coord to, char dir) {
+    size_t fromIdx = from.getRow() * colCount + from.getCol();
+    size_t toIdx = to.getRow() * colCount + to.getCol();
+    if (cellType(cells[fromIdx]) != Type::TENT || (toIdx != fromIdx && cellType(cells[toIdx]) != Type::NONE))
+        return false;
+
+    eraseTent(from.getRow(), from.getCol());
+    insertTent(to.getRow(), to.getCol(), dirCodeOf(dir));
+    return true;
+}
+
+char Board::chooseTreeDir(Coord coord, std::mt19937 &gen) const {
+    size_t r = coord.getRow();
+    size_t c = coord.getCol();
+
+    uint8_t treeDirs[4];
+    size_t numTreeDirs = 0;
+    for (uint8_t dirCode : {uint8_t(3), uint8_t(4), uint8_t(1), uint8_t(2)}) {
+        size_t treeIdx = treeIndexFor(r, c, dirCode);
+        if (treeIdx != numTiles && cellType(cells[treeIdx]) == Type::TREE && treeTentCount[treeIdx] == 0)
+            treeDirs[numTreeDirs++] = dirCode;
+    }
+    if (numTreeDirs == 0)
+        return 'X';
+
+    std::uniform_int_distribution<> dis(0, numTreeDirs - 1);
+    return DIR_CHARS[treeDirs[dis(gen)]];
+}
+
+std::optional<Coord> Board::randomOpenTile(std::mt19937 &gen) const {
+    if (openTiles.size() == 0)
+        return std::nullopt;
+    std::uniform_int_distribution<size_t> dist(0, openTiles.size() - 1);
+    return openTiles.getTileAtIndex(dist(gen));
+}
+
+std::optional<Coord> Board::randomTent(std::mt19937 &gen) const {
+    if (tentTiles.size() == 0)
+        return std::nullopt;
+    std::uniform_int_distribution<size_t> dist(0, tentTiles.size() - 1);
+    return tentTiles.getTileAtIndex(dist(gen));
+}
+
+// Uniform pick from one of the conflict sets.
+static std::optional<Coord> randomMember(const TilesSet& set, std::mt19937 &gen) {
+    if (set.size() == 0)
+        return std::nullopt;
+    std::uniform_int_distribution<size_t> dist(0, set.size() - 1);
+    return set.getTileAtIndex(dist(gen));
+}
+
+std::optional<Coord> Board::randomTouchingTent(std::mt19937 &gen) const {
+    return randomMember(touchingTents, gen);
+}
+
+std::optional<Coord> Board::randomLonelyTent(std::mt19937 &gen) const {
+    return randomMember(lonelyTents, gen);
+}
+
+std::optional<Coord> Board::randomLonelyTree(std::mt19937 &gen) const {
+    return randomMember(lonelyTrees, gen);
+}
+
+std::optional<size_t> Board::randomOffRow(std::mt19937 &gen) const {
+    std::optional<Coord> row = randomMember(offRows, gen);
+    if (!row)
+        return std::nullopt;
+    return row->getRow();
+}
+
+std::optional<size_t> Board::randomOffCol(std::mt19937 &gen) const {
+    std::optional<Coord> col = randomMember(offCols, gen);
+    if (!col)
+        return std::nullopt;
+    return col->getRow();
+}
+
+// Reservoir sample over a strided run of cells, so no candidate list is built.
+std::optional<Coord> Board::randomCellInRow(size_t row, Type type, std::mt19937 &gen) const {
+    std::optional<Coord> pick;
+    size_t seen = 0;
+    for (size_t c = 0; c < colCount; c++) {
+        if (cellType(cells[row * colCount + c]) != type)
+            continue;
+        if (std::uniform_int_distribution<size_t>(0, seen++)(gen) == 0)
+            pick = Coord(row, c);
+    }
+    return pick;
+}
+
+std::optional<Coord> Board::randomCellInCol(size_t col, Type type, std::mt19937 &gen) const {
+    std::optional<Coord> pick;
+    size_t seen = 0;
+    for (size_t r = 0; r < rowCount; r++) {
+        if (cellType(cells[r * colCount + col]) != type)
+            continue;
+        if (std::uniform_int_distribution<size_t>(0, seen++)(gen) == 0)
+            pick = Coord(r, col);
+    }
+    return pick;
+}
+
+std::optional<std::pair<Coord, char>> Board::randomSpotBeside(Coord tree, std::mt19937 &gen) const {
+    size_t r = tree.getRow();
+    size_t c = tree.getCol();
+
+    // The tent sits on the opposite side of the direction it reports.
+    std::pair<Coord, char> spots[4];
+    size_t numSpots = 0;
+    if (r > 0 && cellType(cells[(r - 1) * colCount + c]) == Type::NONE)
+        spots[numSpots++] = {Coord(r - 1, c), 'D'};
+    if (r + 1 < rowCount && cellType(cells[(r + 1) * colCount + c]) == Type::NONE)
+        spots[numSpots++] = {Coord(r + 1, c), 'U'};
+    if (c > 0 && cellType(cells[r * colCount + c - 1]) == Type::NONE)
+        spots[numSpots++] = {Coord(r, c - 1), 'R'};
+    if (c + 1 < colCount && cellType(cells[r * colCount + c + 1]) == Type::NONE)
+        spots[numSpots++] = {Coord(r, c + 1), 'L'};
+    if (numSpots == 0)
+        return std::nullopt;
+
+    std::uniform_int_distribution<size_t> dis(0, numSpots - 1);
+    return spots[dis(gen)];
+}
+
+/*
+/////////////////////////////////////////////////////////////////////////////
+Tree pairing
+/////////////////////////////////////////////////////////////////////////////
+*/
+
+// Visit marks and the explicit DFS stack for augmentPairing, per thread so boards carry no scratch of their own.
+namespace {
+    struct PairingScratch {
+        std::vector<uint32_t> visited;
+        uint32_t stamp = 0;
+        std::vector<std::pair<size_t, uint8_t>> path; // Tent index, dir code currently being tried
+    };
+    thread_local PairingScratch pairingScratch;
+
+    uint32_t nextStamp(size_t numTiles) {
+        PairingScratch& scratch = pairingScratch;
+        if (scratch.visited.size() < numTiles) {
+            scratch.visited.assign(numTiles, 0);
+            scratch.stamp = 0;
+            // Every tent on the path is a different cell, reserving for all of them keeps later searches allocation free.
+            scratch.path.reserve(numTiles);
         }
-        int oldCount = treeTentCount[assocTree];
-        treeTentCount[assocTree] = oldCount - 1;
-        if (oldCount == 1)
-            treeViolations++;   // Now 0 tents: violation appears.
-        else if (oldCount == 2)
-            treeViolations--;   // Now exactly one: violation resolved.
-    } else {
-        lonelyTentViolations--;
+        if (++scratch.stamp == 0) {
+            std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+            scratch.stamp = 1;
+        }
+        return scratch.stamp;
+    }
+}
+
+void Board::repointTent(size_t idx, uint8_t dirCode) {
+    size_t r = idx / colCount;
+    size_t c = idx % colCount;
+    Coord coord(r, c);
+
+    size_t treeIdx = treeIndexFor(r, c, dirCode);
+    if (treeIdx == numTiles || cellType(cells[treeIdx]) != Type::TREE) {
+        dirCode = 0;
+        treeIdx = numTiles;
     }
 
-    // Update overall violation count.
+    detachFromTree(coord, treeIndexFor(r, c, cellDirCode(cells[idx])));
+    cells[idx] = packCell(Type::TENT, dirCode);
+    attachToTree(coord, treeIdx);
+
     violations = rowViolations + colViolations + tentViolations + treeViolations + lonelyTentViolations;
+}
 
-    return true;
+bool Board::unpaired(size_t idx) const {
+    size_t treeIdx = treeIndexFor(idx / colCount, idx % colCount, cellDirCode(cells[idx]));
+    return treeIdx == numTiles || treeTentCount[treeIdx] >= 2;
+}
 
+size_t Board::pairedTent(size_t treeIdx) const {
+    if (treeTentCount[treeIdx] != 1)
+        return numTiles;
+    size_t r = treeIdx / colCount;
+    size_t c = treeIdx % colCount;
+    size_t neighbours[4] = {
+        r > 0 ? treeIdx - colCount : numTiles,
+        r + 1 < rowCount ? treeIdx + colCount : numTiles,
+        c > 0 ? treeIdx - 1 : numTiles,
+        c + 1 < colCount ? treeIdx + 1 : numTiles
+    };
+    for (size_t n : neighbours) {
+        if (n != numTiles && cellType(cells[n]) == Type::TENT
+            && treeIndexFor(n / colCount, n % colCount, cellDirCode(cells[n])) == treeIdx)
+            return n;
+    }
+    return numTiles;
 }
 
-bool Board::moveTent(std::mt19937 &gen) {
-    if(removeTent(gen)){
-        if(addTent(gen))
+// Kuhn-style depth first search, iterative so long paths on big boards cannot overflow a thread's stack.
+bool Board::augmentPairing(size_t idx, size_t maxDepth, uint32_t stamp) {
+    std::vector<uint32_t>& visited = pairingScratch.visited;
+    std::vector<std::pair<size_t, uint8_t>>& path = pairingScratch.path;
+    path.clear();
+    path.emplace_back(idx, 0);
+    visited[idx] = stamp;
+
+    while (!path.empty()) {
+        auto& [tent, dirCode] = path.back();
+        if (dirCode == 4) {
+            path.pop_back();
+            continue;
+        }
+        dirCode++;
+
+        size_t r = tent / colCount;
+        size_t c = tent % colCount;
+        size_t treeIdx = treeIndexFor(r, c, dirCode);
+        // The tree the tent already points at is where the path came from.
+        if (treeIdx == numTiles || cellType(cells[treeIdx]) != Type::TREE || dirCode == cellDirCode(cells[tent])
+            || visited[treeIdx] == stamp)
+            continue;
+        visited[treeIdx] = stamp;
+
+        if (treeTentCount[treeIdx] == 0) {
+            // Every tent on the path moves one tree along, the last one onto the free tree.
+            for (const auto& [pathTent, pathDir] : path)
+                repointTent(pathTent, pathDir);
+            return true;
+        }
+
+        size_t next = pairedTent(treeIdx);
+        if (next != numTiles && visited[next] != stamp && path.size() < maxDepth) {
+            visited[next] = stamp;
+            path.emplace_back(next, 0);
+        }
+    }
+    return false;
+}
+
+bool Board::claimTree(Coord tree) {
+    size_t treeIdx = tree.getRow() * colCount + tree.getCol();
+    if (cellType(cells[treeIdx]) != Type::TREE || treeTentCount[treeIdx] != 0)
+        return false;
+
+    size_t r = tree.getRow();
+    size_t c = tree.getCol();
+    // Neighbour index and the direction a tent there points at the tree.
+    std::pair<size_t, uint8_t> neighbours[4] = {
+        {r > 0 ? treeIdx - colCount : numTiles, 2},
+        {r + 1 < rowCount ? treeIdx + colCount : numTiles, 1},
+        {c > 0 ? treeIdx - 1 : numTiles, 4},
+        {c + 1 < colCount ? treeIdx + 1 : numTiles, 3}
+    };
+    for (const auto& [n, dirCode] : neighbours) {
+        if (n != numTiles && cellType(cells[n]) == Type::TENT && unpaired(n)) {
+            repointTent(n, dirCode);
             return true;
+        }
     }
     return false;
 }
 
+bool Board::repairPairing(Coord tent, size_t maxDepth) {
+    size_t idx = tent.getRow() * colCount + tent.getCol();
+    if (cellType(cells[idx]) != Type::TENT || !unpaired(idx))
+        return false;
+    return augmentPairing(idx, maxDepth, nextStamp(numTiles));
+}
+
+size_t Board::optimisePairing() {
+    size_t before = violations;
+
+    // Phases share one stamp, so a tree that failed to augment is not searched again until the next phase.
+    bool augmented = true;
+    while (augmented) {
+        augmented = false;
+        uint32_t stamp = nextStamp(numTiles);
+        for (size_t k = 0; k < tentTiles.size(); k++) {
+            Coord tent = *tentTiles.getTileAtIndex(k);
+            size_t idx = tent.getRow() * colCount + tent.getCol();
+            if (pairingScratch.visited[idx] != stamp && unpaired(idx)
+                && augmentPairing(idx, std::numeric_limits<size_t>::max(), stamp))
+                augmented = true;
+        }
+    }
+
+    // Every tree beside a leftover 'X' tent is paired now, a maximum matching has no augmenting path of length one.
+    // Such a tent can only stop being lonely by overloading a tree, which costs that tree one violation however many
+    // tents it gets: free on a tree that is overloaded already, a gain once two or more leftover tents share the tree.
+    // Trees with the most leftover neighbours go first.
+    auto leftoverBeside = [this](size_t treeIdx, std::pair<size_t, uint8_t> (&found)[4]) {
+        size_t r = treeIdx / colCount;
+        size_t c = treeIdx % colCount;
+        // Neighbour index and the direction a tent there points at the tree.
+        std::pair<size_t, uint8_t> neighbours[4] = {
+            {r > 0 ? treeIdx - colCount : numTiles, 2},
+            {r + 1 < rowCount ? treeIdx + colCount : numTiles, 1},
+            {c > 0 ? treeIdx - 1 : numTiles, 4},
+            {c + 1 < colCount ? treeIdx + 1 : numTiles, 3}
+        };
+        size_t count = 0;
+        for (const auto& neighbour : neighbours) {
+            if (neighbour.first != numTiles && cellType(cells[neighbour.first]) == Type::TENT
+                && cellDirCode(cells[neighbour.first]) == 0)
+                found[count++] = neighbour;
+        }
+        return count;
+    };
+    for (size_t need = 4; need >= 2; need--) {
+        for (size_t k = 0; k < tentTiles.size(); k++) {
+            Coord tent = *tentTiles.getTileAtIndex(k);
+            size_t idx = tent.getRow() * colCount + tent.getCol();
+            for (uint8_t dirCode = 1; dirCode <= 4 && cellDirCode(cells[idx]) == 0; dirCode++) {
+                size_t treeIdx = treeIndexFor(tent.getRow(), tent.getCol(), dirCode);
+                if (treeIdx == numTiles || cellType(cells[treeIdx]) != Type::TREE)
+                    continue;
+                std::pair<size_t, uint8_t> found[4];
+                size_t count = leftoverBeside(treeIdx, found);
+                if (treeTentCount[treeIdx] < 2 && count < need)
+                    continue;
+                for (size_t f = 0; f < count; f++)
+                    repointTent(found[f].first, found[f].second);
+            }
+        }
+    }
+
+    return before - violations;
+}
+
+/*
+/////////////////////////////////////////////////////////////////////////////
+Move evaluation
+/////////////////////////////////////////////////////////////////////////////
+*/
+
+bool Board::touching(size_t a, size_t b) const {
+    if (a == b)
+        return false;
+    size_t ar = a / colCount, ac = a % colCount;
+    size_t br = b / colCount, bc = b % colCount;
+    return (ar > br ? ar - br : br - ar) <= 1 && (ac > bc ? ac - bc : bc - ac) <= 1;
+}
+
+// Evaluates removing the tent at fromIdx and then adding a tent at toIdx pointing dirCode, without touching the board.
+ViolationDelta Board::moveDelta(size_t fromIdx, size_t toIdx, uint8_t dirCode) const {
+    ViolationDelta delta;
+    bool removing = fromIdx != numTiles;
+    bool adding = toIdx != numTiles;
+    size_t fr = removing ? fromIdx / colCount : 0, fc = removing ? fromIdx % colCount : 0;
+    size_t tr = adding ? toIdx / colCount : 0, tc = adding ? toIdx % colCount : 0;
+
+    // Row/col counters, a row over its target gains a violation per extra tent and loses one per removed tent.
+    if (!(removing && adding && fr == tr)) {
+        if (removing)
+            delta.row += currentRowTents[fr] > rowTentNum[fr] ? -1 : 1;
+        if (adding)
+            delta.row += currentRowTents[tr] >= rowTentNum[tr] ? 1 : -1;
+    }
+    if (!(removing && adding && fc == tc)) {
+        if (removing)
+            delta.col += currentColTents[fc] > colTentNum[fc] ? -1 : 1;
+        if (adding)
+            delta.col += currentColTents[tc] >= colTentNum[tc] ? 1 : -1;
+    }
+
+    // Tent-tent adjacency, the removal is applied first so the addition sees the board without the moved tent.
+    if (removing) {
+        if (adjTentCount[fromIdx] > 0)
+            delta.tent--;
+        size_t rLo = fr > 0 ? fr - 1 : fr, rHi = fr + 1 < rowCount ? fr + 1 : fr;
+        size_t cLo = fc > 0 ? fc - 1 : fc, cHi = fc + 1 < colCount ? fc + 1 : fc;
+        for (size_t i = rLo; i <= rHi; i++) {
+            for (size_t j = cLo; j <= cHi; j++) {
+                size_t n = i * colCount + j;
+                if (n != fromIdx && cellType(cells[n]) == Type::TENT && adjTentCount[n] == 1)
+                    delta.tent--;
+            }
+        }
+    }
+    if (adding) {
+        int ownCount = adjTentCount[toIdx] - (removing && touching(fromIdx, toIdx) ? 1 : 0);
+        if (ownCount > 0)
+            delta.tent++;
+        size_t rLo = tr > 0 ? tr - 1 : tr, rHi = tr + 1 < rowCount ? tr + 1 : tr;
+        size_t cLo = tc > 0 ? tc - 1 : tc, cHi = tc + 1 < colCount ? tc + 1 : tc;
+        for (size_t i = rLo; i <= rHi; i++) {
+            for (size_t j = cLo; j <= cHi; j++) {
+                size_t n = i * colCount + j;
+                if (n == toIdx || n == fromIdx || cellType(cells[n]) != Type::TENT)
+                    continue;
+                int count = adjTentCount[n] - (removing && touching(fromIdx, n) ? 1 : 0);
+                if (count == 0)
+                    delta.tent++;
+            }
+        }
+    }
+
+    // Tree and lonely tent counters.
+    size_t fromTree = numTiles;
+    if (removing) {
+        fromTree = treeIndexFor(fr, fc, cellDirCode(cells[fromIdx]));
+        if (fromTree != numTiles) {
+            uint8_t count = treeTentCount[fromTree];
+            delta.tree += count == 1 ? 1 : (count == 2 ? -1 : 0);
+        } else {
+            delta.lonely--;
+        }
+    }
+    if (adding) {
+        size_t toTree = treeIndexFor(tr, tc, dirCode);
+        if (toTree != numTiles && cellType(cells[toTree]) == Type::TREE) {
+            int count = treeTentCount[toTree] - (toTree == fromTree ? 1 : 0);
+            delta.tree += count == 0 ? -1 : (count == 1 ? 1 : 0);
+        } else {
+            delta.lonely++;
+        }
+    }
+
+    return delta;
+}
+
+ViolationDelta Board::deltaAdd(Coord coord, char dir) const {
+    return moveDelta(numTiles, coord.getRow() * colCount + coord.getCol(), dirCodeOf(dir));
+}
+
+ViolationDelta Board::deltaRemove(Coord coord) const {
+    return moveDelta(coord.getRow() * colCount + coord.getCol(), numTiles, 0);
+}
+
+ViolationDelta Board::deltaMove(Coord from, Coord to, char dir) const {
+    return moveDelta(from.getRow() * colCount + from.getCol(), to.getRow() * colCount + to.getCol(), dirCodeOf(dir));
+}
 
 /*
 /////////////////////////////////////////////////////////////////////////////
@@ -454,17 +914,14 @@ Getters and Setters (Add more if needed)
 
 void Board::bitSetTent(const Coord& location){
     size_t index = location.getRow() * colCount + location.getCol();
-    bitBoard.set(index, true);
+    bitBoard.set(index);
 }
 void Board::bitClearTent(const Coord& location){
     size_t index = location.getRow() * colCount + location.getCol();
-    bitBoard.set(index, false);
+    bitBoard.reset(index);
 }
-size_t Board::countXorBits(const std::bitset<MAX_BOARD_SIZE>& other) const{
-    return (bitBoard ^ other).count();
-}
-std::bitset<Board::MAX_BOARD_SIZE> Board::getBitBoard() const{
-    return bitBoard;
+size_t Board::countXorBits(const BitVector& other) const{
+    return bitBoard.hamming(other);
 }
 
 void Board::printFullBoardInfo() const {
@@ -495,14 +952,19 @@ void Board::printFullBoardInfo() const {
 
     // Print tent adjacency violations.
     std::cout << "Tent Adjacency Violations:\n";
-    for (const auto &entry : tentAdjViolation)
-        std::cout << "(" << entry.first.getRow() << ", " << entry.first.getCol() << "): " << (entry.second ? "Violation" : "No Violation") << "\n";
+    for (size_t i = 0; i < tentTiles.size(); i++) {
+        Coord tent = tentTiles.getTileAtIndex(i).value();
+        bool violating = adjTentCount[tent.getRow() * colCount + tent.getCol()] > 0;
+        std::cout << "(" << tent.getRow() << ", " << tent.getCol() << "): " << (violating ? "Violation" : "No Violation") << "\n";
+    }
     std::cout << "\n";
 
     // Print tree tent counts.
     std::cout << "Tree Tent Counts:\n";
-    for (const auto &entry : treeTentCount)
-        std::cout << "(" << entry.first.getRow() << ", " << entry.first.getCol() << "): " << entry.second << "\n";
+    for (size_t i = 0; i < numTiles; i++) {
+        if (cellType(cells[i]) == Type::TREE)
+            std::cout << "(" << i / colCount << ", " << i % colCount << "): " << (int)treeTentCount[i] << "\n";
+    }
     std::cout << "\n";
 
     // Print violations summary.
@@ -520,19 +982,57 @@ void Board::printFullBoardInfo() const {
 }
 
 Tile Board::getTile(size_t row, size_t col) const{
-    return board[row][col];
+    uint8_t cell = cells[row * colCount + col];
+    return Tile(cellType(cell), row, col, DIR_CHARS[cellDirCode(cell)]);
+}
+
+size_t Board::copyCellsFrom(const Board& donor, size_t begin, size_t end, const uint64_t* mask) {
+    const uint8_t* theirs = donor.cells.data();
+    size_t changed = 0;
+
+    auto takeCell = [&](size_t idx) {
+        if (mask != nullptr && ((mask[idx >> 6] >> (idx & 63)) & 1) == 0)
+            return;
+        size_t r = idx / colCount;
+        size_t c = idx % colCount;
+        // Trees are identical on both boards, so a differing cell is a tent leaving, arriving or changing tree.
+        if (cellType(cells[idx]) == Type::TENT)
+            eraseTent(r, c);
+        if (cellType(theirs[idx]) == Type::TENT)
+            insertTent(r, c, cellDirCode(theirs[idx]));
+        changed++;
+    };
+
+    size_t idx = begin;
+    for (; idx + 8 <= end; idx += 8) {
+        uint64_t mine, other;
+        std::memcpy(&mine, cells.data() + idx, sizeof(mine));
+        std::memcpy(&other, theirs + idx, sizeof(other));
+        uint64_t diff = mine ^ other;
+        while (diff != 0) {
+            int byte = std::countr_zero(diff) >> 3;
+            takeCell(idx + byte);
+            diff &= ~(uint64_t(0xFF) << (byte * 8));
+        }
+    }
+    for (; idx < end; idx++) {
+        if (cells[idx] != theirs[idx])
+            takeCell(idx);
+    }
+
+    return changed;
 }
 
-void Board::setTile(const Tile tile, std::mt19937 gen){
+void Board::setTile(const Tile tile, std::mt19937 &gen){
     size_t col = tile.getCoord().getCol();
     size_t row = tile.getCoord().getRow();
 
-    if (board[row][col].getType() == Type::NONE && tile.getType() == Type::TENT)
-        placeTent(board[row][col], gen);
-    else if (board[row][col].getType() == Type::TENT && tile.getType() == Type::NONE)
-        deleteTent(board[row][col].getCoord());
-    //else
-        //board[row][col] = tile;
+    if (getType(row, col) == Type::NONE && tile.getType() == Type::TENT) {
+        Tile current = getTile(row, col);
+        placeTent(current, gen);
+    }
+    else if (getType(row, col) == Type::TENT && tile.getType() == Type::NONE)
+        deleteTent(Coord(row, col));
 
 }
 
@@ -552,7 +1052,7 @@ void Board::debugPrintViolations(){
 
         Coord tentCoord = tentTiles.getTileAtIndex(i).value();
 
-        std::cout << tentCoord.getRow()+1 << " " << tentCoord.getCol()+1 << " " << board.at(tentCoord.getRow()).at(tentCoord.getCol()).getDir() << std::endl;
+        std::cout << tentCoord.getRow()+1 << " " << tentCoord.getCol()+1 << " " << getDir(tentCoord.getRow(), tentCoord.getCol()) << std::endl;
 
     }
 
@@ -564,6 +1064,15 @@ size_t Board::getViolations() const{
     return violations;
 }
 
-std::vector<std::vector<Tile>> Board::getBoard(){
+std::vector<std::vector<Tile>> Board::getBoard() const{
+    std::vector<std::vector<Tile>> board;
+    board.reserve(rowCount);
+    for (size_t i = 0; i < rowCount; i++) {
+        std::vector<Tile> row;
+        row.reserve(colCount);
+        for (size_t j = 0; j < colCount; j++)
+            row.push_back(getTile(i, j));
+        board.push_back(std::move(row));
+    }
     return board;
 }
\ No newline at end of file
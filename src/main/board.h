@@ -1,21 +1,37 @@
 #pragma once
 #include "tile.h"
 #include "tilesSet.h"
+#include "bitVector.h"
 #include <vector>
-#include <unordered_set>
 #include <random>
-#include <bitset>
+#include <cstdint>
+
+/**
+ * @brief Signed change of every violation counter caused by a move, as reported by the Board::delta* family
+ */
+struct ViolationDelta {
+    int row = 0;
+    int col = 0;
+    int tent = 0;
+    int tree = 0;
+    int lonely = 0;
+
+    int total() const { return row + col + tent + tree + lonely; }
+};
 
 class Board{
     private:
-        static constexpr std::size_t MAX_BOARD_SIZE = 250*400;
+        // Packed cell layout: bits 0-1 hold the Type, bits 2-4 hold an index into DIR_CHARS
+        static constexpr uint8_t TYPE_MASK = 0x3;
+        static constexpr uint8_t DIR_SHIFT = 2;
+        static constexpr char DIR_CHARS[5] = {'X', 'U', 'D', 'L', 'R'};
 
         // Board dimensions
         size_t rowCount = 0;
         size_t colCount = 0;
 
-        // Board itself, populated by Tiles
-        std::vector<std::vector<Tile>> board;
+        // Board itself, one packed byte per cell indexed by row * colCount + col
+        std::vector<uint8_t> cells;
 
         // Target vals for row/col tents
         std::vector<size_t> rowTentNum;
@@ -25,11 +41,11 @@ class Board{
         std::vector<size_t> currentRowTents;
         std::vector<size_t> currentColTents;
         
-        // Check if the tent already violates a tent-tent violation
-        std::unordered_map<Coord, bool> tentAdjViolation;
+        // Number of tents in the 8-neighbourhood of every cell, a tent violates tent-tent if its count is non-zero
+        std::vector<uint8_t> adjTentCount;
 
-        // Map of all trees with an count of how many tents are attached, for tent-tree violations
-        std::unordered_map<Coord, size_t> treeTentCount;
+        // Number of tents attached to every cell (only non-zero on trees), for tent-tree violations
+        std::vector<uint8_t> treeTentCount;
         size_t numTrees;
 
         // Row/col violations
@@ -47,20 +63,63 @@ class Board{
         size_t violations;
 
         // Num tiles
-        size_t numTiles = rowCount * colCount;
+        size_t numTiles = 0;
         
         TilesSet openTiles;
         TilesSet tentTiles;
 
-        std::bitset<MAX_BOARD_SIZE> bitBoard;
+        // Conflict sets, updated with the counters so mutations can go straight to a violation
+        TilesSet touchingTents;   // Tents with another tent in their 8-neighbourhood
+        TilesSet lonelyTents;     // Tents not attached to a tree ('X')
+        TilesSet lonelyTrees;     // Trees with no tent attached
+        TilesSet offRows;         // Rows whose tent count misses the target, stored as Coord(row, 0)
+        TilesSet offCols;         // Cols whose tent count misses the target, stored as Coord(col, 0)
+
+        // One bit per cell, set where a tent stands, for Hamming distances between boards
+        BitVector bitBoard;
+
+        // Packing helpers for the cells array
+        static constexpr uint8_t packCell(Type type, uint8_t dirCode) { return static_cast<uint8_t>(type) | (dirCode << DIR_SHIFT); }
+        static constexpr Type cellType(uint8_t cell) { return static_cast<Type>(cell & TYPE_MASK); }
+        static constexpr uint8_t cellDirCode(uint8_t cell) { return cell >> DIR_SHIFT; }
+        static uint8_t dirCodeOf(char dir);
+
+        // Returns the index of the tree a tent at (r, c) points to with dirCode, or numTiles if it points at nothing
+        size_t treeIndexFor(size_t r, size_t c, uint8_t dirCode) const;
+
+        // Helper functions to register/unregister a tent and update every counter around it, O(1)
+        void insertTent(size_t r, size_t c, uint8_t dirCode);
+        void eraseTent(size_t r, size_t c);
+
+        // Tree/lonely-tent bookkeeping for a tent taking or leaving treeIdx (numTiles for 'X'), O(1)
+        void attachToTree(const Coord& coord, size_t treeIdx);
+        void detachFromTree(const Coord& coord, size_t treeIdx);
+
+        // Points the tent at idx at the tree in dirCode without moving it, O(1)
+        void repointTent(size_t idx, uint8_t dirCode);
+
+        // True when the tent at idx is 'X' or shares its tree with another tent
+        bool unpaired(size_t idx) const;
 
-        // Helper functions to update a tent’s adjacent violation status.
-        std::unordered_set<Coord> getAdjacentTents(const Coord &coord) const;
-        void updateTentAdjacencyForCoord(const Coord &coord);
+        // The one tent attached to a tree with treeTentCount 1, numTiles otherwise
+        size_t pairedTent(size_t treeIdx) const;
+
+        // Alternating-path search from an unpaired tent to a tree with no tent, re-pointing the path on success
+        bool augmentPairing(size_t idx, size_t maxDepth, uint32_t stamp);
 
         // Helper functions to update row/col violations for tents
         void updateRowAndColForTent(const size_t, const size_t, const bool);
 
+        // Shared implementation of the delta* family, numTiles for fromIdx/toIdx means no removal/addition
+        ViolationDelta moveDelta(size_t fromIdx, size_t toIdx, uint8_t dirCode) const;
+
+        // True when two distinct cells touch, including diagonally
+        bool touching(size_t a, size_t b) const;
+
+        // Constructor helpers: size every buffer for an empty board, then index the open cells once tents are in
+        void resetCounters();
+        void registerOpenTiles();
+
     public:
 
         Board(
@@ -72,10 +131,41 @@ class Board{
             size_t numTrees
         );
 
-        //Board(const Board& other);
-        Board(const Board& other);
-        Board& operator=(const Board& other);
+        /**
+         * @brief Builds a board straight from a flat array of packed cells indexed by row * colCount + col
+         * Used by the input parser so no 2D Tile grid is built. A plain Type cast to uint8_t is a valid
+         * packed cell, and the layout matches getCells() so a board can be rebuilt from its own cells.
+         */
+        Board(
+            size_t rowCount,
+            size_t colCount,
+            std::vector<size_t> rowTentNum,
+            std::vector<size_t> colTentNum,
+            const std::vector<uint8_t>& packedCells
+        );
+
+        // Every member is a value type, so copies and moves are plain member-wise operations
+        Board(const Board& other) = default;
+        Board(Board&& other) noexcept = default;
+        Board& operator=(const Board& other) = default;
+        Board& operator=(Board&& other) noexcept = default;
+
+        /**
+         * @brief Copies other into this board, reusing this board's buffers when they are large enough
+         * Used to refill the GA generation arrays without reallocating every child
+         */
+        void cloneFrom(const Board& other);
         
+        /**
+         * @brief Makes cells [begin, end) match donor, the crossover primitive
+         * Cells are compared eight at a time as 64-bit words of the packed cell array, so stretches where both
+         * boards agree cost one XOR; only differing cells go through the incremental tent updates. When mask is
+         * given, cell i is only taken from donor if bit i % 64 of mask[i / 64] is set. Both boards must come
+         * from the same input.
+         * @return number of cells that changed
+         */
+        size_t copyCellsFrom(const Board& donor, size_t begin, size_t end, const uint64_t* mask = nullptr);
+
         /**
          * @brief Checks for all violations on the board at the current moment
          * @return current number of violations
@@ -111,6 +201,88 @@ class Board{
          */
         bool deleteTent(Coord coord);
     
+        /**
+         * @brief Places a tent on an open cell associated with the tree in dir ('X' or a non-tree means lonely)
+         * @return true 
+         * @return false if the cell is not open
+         */
+        bool placeTent(Coord coord, char dir);
+
+        /**
+         * @brief Moves the tent at from onto the open cell to (or re-associates it when to == from)
+         * @return true 
+         * @return false if from is not a tent or to is not open
+         */
+        bool moveTent(Coord from, Coord to, char dir);
+
+        /**
+         * @brief Picks the direction placeTent would use at coord: a random adjacent tree with no tent, else 'X'
+         */
+        char chooseTreeDir(Coord coord, std::mt19937&) const;
+
+        /**
+         * @brief Random open cell / random tent, std::nullopt when there are none
+         */
+        std::optional<Coord> randomOpenTile(std::mt19937&) const;
+        std::optional<Coord> randomTent(std::mt19937&) const;
+
+        /**
+         * @brief Random member of a conflict set, std::nullopt when it is empty
+         * Touching tents have another tent in their 8-neighbourhood, lonely tents point at no tree ('X'), lonely
+         * trees have no tent attached. Off-quota rows/cols come back as their index.
+         */
+        std::optional<Coord> randomTouchingTent(std::mt19937&) const;
+        std::optional<Coord> randomLonelyTent(std::mt19937&) const;
+        std::optional<Coord> randomLonelyTree(std::mt19937&) const;
+        std::optional<size_t> randomOffRow(std::mt19937&) const;
+        std::optional<size_t> randomOffCol(std::mt19937&) const;
+
+        /**
+         * @brief Random cell of the given type in a row or column, std::nullopt if it has none, O(length)
+         */
+        std::optional<Coord> randomCellInRow(size_t row, Type type, std::mt19937&) const;
+        std::optional<Coord> randomCellInCol(size_t col, Type type, std::mt19937&) const;
+
+        /**
+         * @brief Random open cell orthogonally next to tree, with the direction a tent there would point at it
+         */
+        std::optional<std::pair<Coord, char>> randomSpotBeside(Coord tree, std::mt19937&) const;
+
+        /**
+         * @brief Re-association move, points an unpaired tent next to tree (one that is 'X' or shares its tree) at it
+         * @return false if tree has a tent already or no such tent stands beside it
+         */
+        bool claimTree(Coord tree);
+
+        /**
+         * @brief Re-pairs an unpaired tent through an augmenting path of at most maxDepth tents, O(4^maxDepth)
+         * Every tent on the path switches to the next tree along it and the last one takes a tree with no tent,
+         * so a success always removes at least one violation and never moves a tent.
+         * @return false if the tent is paired already or no such path exists
+         */
+        bool repairPairing(Coord tent, size_t maxDepth);
+
+        /**
+         * @brief Re-points every tent so the number of trees with exactly one tent is maximal for the current layout
+         * Augmenting paths from every unpaired tent until none is left (a maximum tent-tree matching). Leftover 'X'
+         * tents then group up: they join trees that are overloaded already, and share a paired tree when two or more
+         * of them stand beside it, trading their lonely violations for that tree's single one. The grouping is greedy
+         * (most leftover neighbours first) on top of whichever maximum matching the search found, so it is a strong
+         * local optimum rather than a proven minimum. O(tents) per phase, tents stay put.
+         * @return violations removed
+         */
+        size_t optimisePairing();
+
+        /**
+         * @brief Read-only move evaluation, O(1) from the 3x3 neighbourhood and the row/col counters
+         * The board is not modified. deltaAdd expects an open cell, deltaRemove a tent, and deltaMove a tent
+         * moving onto an open cell (or onto itself, which evaluates a re-association to dir).
+         * @return the change every violation counter would see if the move was applied
+         */
+        ViolationDelta deltaAdd(Coord coord, char dir) const;
+        ViolationDelta deltaRemove(Coord coord) const;
+        ViolationDelta deltaMove(Coord from, Coord to, char dir) const;
+
         /**
          * @brief Should be a combination of remove tent and place tent, but you can move the tent to any neighbor
          * Return values are used as error trackers; this is basically a void function.
@@ -137,7 +309,7 @@ class Board{
          * 0 Indexed
          * @return Tile 
          */
-        void setTile(const Tile, std::mt19937);
+        void setTile(const Tile, std::mt19937&);
 
         /**
          * @brief Draws the current state of the board
@@ -156,15 +328,29 @@ class Board{
          */
         size_t getNumCols() const { return colCount; };
 
-        std::vector<std::vector<Tile>> getBoard();
+        /**
+         * @brief Fast accessors for a single cell, 0 Indexed
+         */
+        Type getType(size_t row, size_t col) const { return cellType(cells[row * colCount + col]); }
+        char getDir(size_t row, size_t col) const { return DIR_CHARS[cellDirCode(cells[row * colCount + col])]; }
+
+        /**
+         * @brief Builds a full 2D copy of the board, prefer getTile/getType for single cells
+         */
+        std::vector<std::vector<Tile>> getBoard() const;
 
         void printFullBoardInfo() const;
         
         // Bitset operations
         void bitSetTent(const Coord&);
         void bitClearTent(const Coord&);
-        size_t countXorBits(const std::bitset<MAX_BOARD_SIZE>&) const;
-        std::bitset<MAX_BOARD_SIZE> getBitBoard() const;
+        size_t countXorBits(const BitVector&) const;
+        const BitVector& getBitBoard() const { return bitBoard; }
+
+        /**
+         * @brief Number of cells where exactly one of the two boards has a tent, no copies involved
+         */
+        size_t hammingDistance(const Board& other) const { return bitBoard.hamming(other.bitBoard); }
 
         // Getters and Setters for Board private variables
 
@@ -184,13 +370,17 @@ class Board{
         const std::vector<size_t>& getCurrentColTents() const { return currentColTents; }
         void setCurrentColTents(const std::vector<size_t>& cct) { currentColTents = cct; }
 
-        // Getter and Setter for tentAdjViolation
-        const std::unordered_map<Coord, bool>& getTentAdjViolation() const { return tentAdjViolation; }
-        void setTentAdjViolation(const std::unordered_map<Coord, bool>& tav) { tentAdjViolation = tav; }
+        // Getter and Setter for cells
+        const std::vector<uint8_t>& getCells() const { return cells; }
+        void setCells(const std::vector<uint8_t>& c) { cells = c; }
+
+        // Getter and Setter for adjTentCount
+        const std::vector<uint8_t>& getAdjTentCount() const { return adjTentCount; }
+        void setAdjTentCount(const std::vector<uint8_t>& atc) { adjTentCount = atc; }
 
         // Getter and Setter for treeTentCount
-        const std::unordered_map<Coord, size_t>& getTreeTentCount() const { return treeTentCount; }
-        void setTreeTentCount(const std::unordered_map<Coord, size_t>& ttc) { treeTentCount = ttc; }
+        const std::vector<uint8_t>& getTreeTentCount() const { return treeTentCount; }
+        void setTreeTentCount(const std::vector<uint8_t>& ttc) { treeTentCount = ttc; }
 
         // Getter and Setter for numTrees
         size_t getNumTrees() const { return numTrees; }
@@ -224,11 +414,13 @@ class Board{
         size_t getNumTiles() const { return numTiles; }
         void setNumTiles(size_t nt) { numTiles = nt; }
   
-        TilesSet getOpenTilesData() const { return openTiles; }
+        const TilesSet& getOpenTilesData() const { return openTiles; }
 
-        TilesSet getTentTilesData() const { return tentTiles; }
+        const TilesSet& getTentTilesData() const { return tentTiles; }
 
-        std::vector<std::vector<Tile>> getBoard() const {
-            return board;
-        }
+        const TilesSet& getTouchingTents() const { return touchingTents; }
+        const TilesSet& getLonelyTents() const { return lonelyTents; }
+        const TilesSet& getLonelyTrees() const { return lonelyTrees; }
+        const TilesSet& getOffRows() const { return offRows; }
+        const TilesSet& getOffCols() const { return offCols; }
 };
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "clusterSolver.h"
+#include "annealer.h"
+#include "tentMatcher.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <omp.h>
+
+ClusterSolver::ClusterSolver(const Board& board, unsigned seed) : startingBoard(board), seed(seed) {
+    decompose();
+}
+
+/*
+////////////////////////////////////////////////////
+Decomposition
+////////////////////////////////////////////////////
+*/
+
+static size_t findRoot(std::vector<size_t>& parent, size_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+static void unite(std::vector<size_t>& parent, size_t a, size_t b) {
+    a = findRoot(parent, a);
+    b = findRoot(parent, b);
+    if (a != b)
+        parent[std::max(a, b)] = std::min(a, b);
+}
+
+void ClusterSolver::decompose() {
+    constexpr int NO_TREE = -1;
+    size_t rows = startingBoard.getNumRows();
+    size_t cols = startingBoard.getNumCols();
+    const std::vector<size_t>& rowTentNum = startingBoard.getRowTentNum();
+    const std::vector<size_t>& colTentNum = startingBoard.getColTentNum();
+
+    std::vector<size_t> trees;
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (startingBoard.getType(r, c) == Type::TREE)
+                trees.push_back(r * cols + c);
+        }
+    }
+
+    // Every candidate cell remembers one tree it serves, trees sharing a candidate are merged on the spot.
+    std::vector<size_t> parent(trees.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    std::vector<int> owner(rows * cols, NO_TREE);
+    std::vector<size_t> candidates;
+    for (size_t t = 0; t < trees.size(); t++) {
+        size_t r = trees[t] / cols;
+        size_t c = trees[t] % cols;
+        size_t neighbours[4];
+        size_t numNeighbours = 0;
+        if (r > 0) neighbours[numNeighbours++] = trees[t] - cols;
+        if (r + 1 < rows) neighbours[numNeighbours++] = trees[t] + cols;
+        if (c > 0) neighbours[numNeighbours++] = trees[t] - 1;
+        if (c + 1 < cols) neighbours[numNeighbours++] = trees[t] + 1;
+
+        for (size_t k = 0; k < numNeighbours; k++) {
+            size_t cell = neighbours[k];
+            size_t cr = cell / cols;
+            size_t cc = cell % cols;
+            if (startingBoard.getType(cr, cc) != Type::NONE || rowTentNum[cr] == 0 || colTentNum[cc] == 0)
+                continue;
+            if (owner[cell] == NO_TREE) {
+                owner[cell] = static_cast<int>(t);
+                candidates.push_back(cell);
+            } else {
+                unite(parent, owner[cell], t);
+            }
+        }
+    }
+
+    // Touching candidates would make tent-tent violations cross clusters, so their trees are merged too.
+    // Only the forward half of the 8-neighbourhood is needed since every pair is seen from its earlier cell.
+    for (size_t cell : candidates) {
+        size_t r = cell / cols;
+        size_t c = cell % cols;
+        const int dr[4] = {0, 1, 1, 1};
+        const int dc[4] = {1, -1, 0, 1};
+        for (int k = 0; k < 4; k++) {
+            int nr = static_cast<int>(r) + dr[k], nc = static_cast<int>(c) + dc[k];
+            if (nr < 0 || nc < 0 || nr >= static_cast<int>(rows) || nc >= static_cast<int>(cols))
+                continue;
+            int other = owner[nr * cols + nc];
+            if (other != NO_TREE)
+                unite(parent, owner[cell], other);
+        }
+    }
+
+    // Trees without any candidate cell cannot be helped by any placement and get no cluster.
+    std::vector<int> clusterOf(trees.size(), NO_TREE);
+    for (size_t cell : candidates) {
+        size_t root = findRoot(parent, owner[cell]);
+        if (clusterOf[root] == NO_TREE) {
+            clusterOf[root] = static_cast<int>(clusters.size());
+            clusters.emplace_back();
+        }
+        clusters[clusterOf[root]].cells.push_back(cell);
+    }
+    for (size_t t = 0; t < trees.size(); t++) {
+        int cluster = clusterOf[findRoot(parent, t)];
+        if (cluster != NO_TREE)
+            clusters[cluster].trees.push_back(trees[t]);
+    }
+
+    // Largest first so the dynamic schedule does not end on one long cluster.
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &a, const Cluster &b) {
+        return a.cells.size() > b.cells.size();
+    });
+}
+
+/*
+////////////////////////////////////////////////////
+Cluster search
+////////////////////////////////////////////////////
+*/
+
+// Puts every cell of cells into the state given by dirs, 0 meaning open and anything else a tent pointing that way.
+static void applyAssignment(Board& board, const std::vector<size_t>& cells, const std::vector<char>& dirs) {
+    size_t cols = board.getNumCols();
+    for (size_t i = 0; i < cells.size(); i++) {
+        size_t r = cells[i] / cols;
+        size_t c = cells[i] % cols;
+        Coord coord(r, c);
+        bool isTent = board.getType(r, c) == Type::TENT;
+        if (dirs[i] == 0) {
+            if (isTent)
+                board.deleteTent(coord);
+        } else if (!isTent) {
+            board.placeTent(coord, dirs[i]);
+        } else if (board.getDir(r, c) != dirs[i]) {
+            board.moveTent(coord, coord, dirs[i]);
+        }
+    }
+}
+
+static void readAssignment(const Board& board, const std::vector<size_t>& cells, std::vector<char>& dirs) {
+    size_t cols = board.getNumCols();
+    dirs.resize(cells.size());
+    for (size_t i = 0; i < cells.size(); i++) {
+        size_t r = cells[i] / cols;
+        size_t c = cells[i] % cols;
+        dirs[i] = board.getType(r, c) == Type::TENT ? board.getDir(r, c) : 0;
+    }
+}
+
+void ClusterSolver::solveCluster(const Cluster& cluster, Board& board, std::mt19937& gen) const {
+    const std::vector<size_t>& cells = cluster.cells;
+    size_t cols = board.getNumCols();
+    size_t rows = board.getNumRows();
+
+    // Scores are relative to the board as handed in, only the cluster's own cells ever change.
+    int score = 0;
+    int bestScore = 0;
+    std::vector<char> best;
+    readAssignment(board, cells, best);
+
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    const char dirs[4] = {'U', 'D', 'L', 'R'};
+    std::uniform_int_distribution<size_t> cellDist(0, cells.size() - 1);
+    std::uniform_real_distribution<double> unitDist(0.0, 1.0);
+
+    const double startTemperature = 1.0;
+    const double endTemperature = 0.05;
+    size_t moves = cells.size() * MOVES_PER_CELL;
+    double temperature = startTemperature;
+    for (size_t m = 0; m < moves; m++) {
+        if ((m & 1023) == 0)
+            temperature = startTemperature * std::pow(endTemperature / startTemperature, static_cast<double>(m) / moves);
+
+        size_t cell = cells[cellDist(gen)];
+        size_t r = cell / cols;
+        size_t c = cell % cols;
+        Coord coord(r, c);
+
+        int delta;
+        char dir = 0;
+        bool reassociate = false;
+        if (board.getType(r, c) == Type::NONE) {
+            dir = board.chooseTreeDir(coord, gen);
+            delta = board.deltaAdd(coord, dir).total();
+        } else if (gen() & 1) {
+            delta = board.deltaRemove(coord).total();
+        } else {
+            // Re-associate with another adjacent tree, or none.
+            int k = gen() % 5;
+            dir = 'X';
+            if (k < 4) {
+                int nr = static_cast<int>(r) + dr[k], nc = static_cast<int>(c) + dc[k];
+                if (nr >= 0 && nc >= 0 && nr < static_cast<int>(rows) && nc < static_cast<int>(cols) && board.getType(nr, nc) == Type::TREE)
+                    dir = dirs[k];
+            }
+            if (dir == board.getDir(r, c))
+                continue;
+            reassociate = true;
+            delta = board.deltaMove(coord, coord, dir).total();
+        }
+
+        if (delta > 0 && unitDist(gen) >= std::exp(-delta / temperature))
+            continue;
+
+        if (reassociate)
+            board.moveTent(coord, coord, dir);
+        else if (dir != 0)
+            board.placeTent(coord, dir);
+        else
+            board.deleteTent(coord);
+
+        score += delta;
+        if (score < bestScore) {
+            bestScore = score;
+            readAssignment(board, cells, best);
+        }
+    }
+
+    applyAssignment(board, cells, best);
+}
+
+/*
+////////////////////////////////////////////////////
+Running and Output
+////////////////////////////////////////////////////
+*/
+
+Board ClusterSolver::solve(double reconcileSeconds) {
+    std::mt19937 gen(seed);
+    Board seeded = TentMatcher(startingBoard).buildBoard(&gen);
+    size_t seededViolations = seeded.getViolations();
+
+    // Clusters own disjoint cells, so every thread can write its results straight into the shared assignment.
+    std::vector<std::vector<char>> assignments(clusters.size());
+    #pragma omp parallel
+    {
+        Board local(seeded);
+        std::mt19937 localGen(seed + 1 + omp_get_thread_num());
+
+        #pragma omp for schedule(dynamic, 1)
+        for (size_t k = 0; k < clusters.size(); k++) {
+            solveCluster(clusters[k], local, localGen);
+            readAssignment(local, clusters[k].cells, assignments[k]);
+        }
+    }
+
+    Board merged(seeded);
+    for (size_t k = 0; k < clusters.size(); k++)
+        applyAssignment(merged, clusters[k].cells, assignments[k]);
+    size_t mergedViolations = merged.getViolations();
+
+    // Every thread counted the other threads' clusters as seeded, one anneal over the whole board settles the row/col counts.
+    Annealer annealer(nullptr, merged, 0.5, 0.02, reconcileSeconds, seed);
+    annealer.anneal();
+
+    if (!quiet)
+        std::cout << "clusters: " << clusters.size() << " clusters (largest " << (clusters.empty() ? 0 : clusters[0].cells.size())
+                  << " cells), seed " << seededViolations << ", merged " << mergedViolations
+                  << ", reconciled " << annealer.getBestViolations() << std::endl;
+
+    return annealer.getBestBoard();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "board.h"
+
+#include <vector>
+#include <random>
+
+/**
+ * @brief Splits a board into independent tree clusters and solves them in parallel
+ * A candidate cell is an open cell orthogonally beside a tree whose row and column both have a non-zero quota.
+ * Two trees land in the same cluster when they share a candidate cell or when candidate cells of theirs touch,
+ * so tents placed in different clusters can never affect each other's tent, tree or lonely violations.
+ * Clusters are only coupled through the row/col quotas. Every thread anneals its clusters on a full copy of the
+ * seeded board, so the row/col counts it sees hold its own finished clusters and every other cluster as it was
+ * seeded; changes other threads make are invisible to it. A final anneal over the merged board reconciles the quotas.
+ */
+class ClusterSolver {
+    public:
+    /**
+     * @brief Trees of one cluster and the candidate cells they can use, as linear cell indices
+     */
+    struct Cluster {
+        std::vector<size_t> trees;
+        std::vector<size_t> cells;
+    };
+
+    /**
+     * @brief Runs the decomposition, O(cells) with a union-find over the trees
+     */
+    explicit ClusterSolver(const Board& board, unsigned seed = std::random_device{}());
+
+    /**
+     * @brief Solves every cluster in parallel from the matching seed, then reconciles the quotas
+     * @param reconcileSeconds time budget of the final anneal over the whole board
+     * @return the merged and reconciled board
+     */
+    Board solve(double reconcileSeconds);
+
+    /**
+     * @brief Leaves out the summary line solve prints, for --quiet
+     */
+    void setQuiet(bool enabled) { quiet = enabled; }
+
+    /**
+     * @brief Clusters with at least one candidate cell, largest first
+     */
+    const std::vector<Cluster>& getClusters() const { return clusters; }
+
+    private:
+
+    // Annealing moves per candidate cell of a cluster
+    static constexpr size_t MOVES_PER_CELL = 400;
+
+    const Board& startingBoard;
+    std::vector<Cluster> clusters;
+    unsigned seed;
+    bool quiet = false;
+
+    void decompose();
+
+    /**
+     * @brief Anneals the cells of one cluster on board
+     * Leaves the best assignment of the cluster's cells on board.
+     */
+    void solveCluster(const Cluster&, Board& board, std::mt19937& gen) const;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <functional>
+#include <cstdint>
 
 /**
  * @brief Simple general coordinate class that has hashing, simply keeps the row and column with 1 indexing
@@ -28,9 +29,8 @@ namespace std {
     template <>
     struct hash<Coord> {
         size_t operator()(const Coord &c) const noexcept {
-            size_t h1 = std::hash<int>{}(c.getRow());
-            size_t h2 = std::hash<int>{}(c.getCol());
-            return h1 ^ (h2 << 1); // Combines the two hashes
+            // Row and col each get their own 32 bits, XOR-ing the small ints directly collided for most of the board
+            return (static_cast<size_t>(static_cast<uint32_t>(c.getRow())) << 32) | static_cast<uint32_t>(c.getCol());
         }
     };
 }
\ No newline at end of file
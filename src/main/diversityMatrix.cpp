@@ -0,0 +1,59 @@
+#include "diversityMatrix.h"
+
+#include <algorithm>
+#include <omp.h>
+
+void DiversityMatrix::compute(const std::vector<Board>& population) {
+    if (population.size() != count || blockPairs.empty()) {
+        count = population.size();
+        distances.assign(count * count, 0);
+
+        // Upper triangle of block pairs, flattened so the schedule can balance them.
+        size_t blocks = (count + BLOCK - 1) / BLOCK;
+        blockPairs.clear();
+        for (size_t bi = 0; bi < blocks; bi++) {
+            for (size_t bj = bi; bj < blocks; bj++)
+                blockPairs.emplace_back(bi, bj);
+        }
+    }
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t p = 0; p < blockPairs.size(); p++) {
+        size_t iEnd = std::min((blockPairs[p].first + 1) * BLOCK, count);
+        size_t jEnd = std::min((blockPairs[p].second + 1) * BLOCK, count);
+        for (size_t i = blockPairs[p].first * BLOCK; i < iEnd; i++) {
+            const BitVector& a = population[i].getBitBoard();
+            // Diagonal blocks only count each pair once.
+            size_t jStart = blockPairs[p].first == blockPairs[p].second ? i + 1 : blockPairs[p].second * BLOCK;
+            for (size_t j = jStart; j < jEnd; j++) {
+                uint32_t d = static_cast<uint32_t>(a.hamming(population[j].getBitBoard()));
+                distances[i * count + j] = d;
+                distances[j * count + i] = d;
+            }
+        }
+    }
+}
+
+double DiversityMatrix::mean() const {
+    if (count < 2)
+        return 0.0;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++)
+            sum += distances[i * count + j];
+    }
+    return static_cast<double>(sum) / (count * (count - 1) / 2);
+}
+
+void DiversityMatrix::nicheCounts(double radius, std::vector<double>& counts) const {
+    counts.assign(count, 1.0);
+    if (radius <= 0.0)
+        return;
+    for (size_t i = 0; i < count; i++) {
+        const uint32_t* row = distances.data() + i * count;
+        double niche = 0.0;
+        for (size_t j = 0; j < count; j++)
+            niche += std::max(0.0, 1.0 - row[j] / radius);
+        counts[i] = niche;
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "board.h"
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief Pairwise Hamming distances of a whole population, rebuilt once per generation
+ * The N x N matrix is filled block by block so a block's bitboards stay in cache while every pair between two
+ * blocks is counted, with the block pairs spread over the OpenMP threads. Selection, fitness sharing and
+ * crowding read distances from here instead of recounting them per call.
+ */
+class DiversityMatrix {
+    public:
+    // Boards per block, 2 * BLOCK bitboards of a 250x400 board still fit in L2
+    static constexpr size_t BLOCK = 8;
+
+    /**
+     * @brief Recomputes every distance of population, O(N^2 * cells / 64 / 2)
+     */
+    void compute(const std::vector<Board>& population);
+
+    uint32_t distance(size_t i, size_t j) const { return distances[i * count + j]; }
+    size_t size() const { return count; }
+
+    /**
+     * @brief Mean distance over all distinct pairs, 0 below two boards
+     */
+    double mean() const;
+
+    /**
+     * @brief Niche count of every board for fitness sharing, sum over j of max(0, 1 - d(i, j) / radius)
+     * Always at least 1, a board counts itself.
+     */
+    void nicheCounts(double radius, std::vector<double>& counts) const;
+
+    private:
+    size_t count = 0;
+    std::vector<uint32_t> distances;
+    // Kept between calls so a population of the same size is recomputed without allocating
+    std::vector<std::pair<size_t, size_t>> blockPairs;
+};
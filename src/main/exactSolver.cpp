@@ -0,0 +1,252 @@
+#include "exactSolver.h"
+#include "annealer.h"
+#include "tentMatcher.h"
+#include "output.h"
+#include "stopSignal.h"
+
+#include <algorithm>
+#include <iostream>
+
+ExactSolver::ExactSolver(char * filePath, const Board& board, size_t nodeLimit)
+    : filePath(filePath),
+      board(board),
+      bestBoard(board),
+      bestViolations(board.getViolations()),
+      nodeLimit(nodeLimit),
+      rowCount(board.getNumRows()),
+      colCount(board.getNumCols())
+{
+    const std::vector<uint8_t>& treeCounts = board.getTreeTentCount();
+
+    remainingRow.assign(rowCount, 0);
+    remainingCol.assign(colCount, 0);
+    for (size_t r = 0; r < rowCount; r++) {
+        for (size_t c = 0; c < colCount; c++) {
+            if (board.getType(r, c) == Type::NONE) {
+                cells.push_back(r * colCount + c);
+                remainingRow[r]++;
+                remainingCol[c]++;
+            }
+        }
+    }
+
+    // A tree is settled once the last open cell beside it (in decision order) is decided.
+    finalizeAt.assign(rowCount * colCount, {});
+    for (size_t r = 0; r < rowCount; r++) {
+        for (size_t c = 0; c < colCount; c++) {
+            if (board.getType(r, c) != Type::TREE)
+                continue;
+            size_t tree = r * colCount + c;
+            // Neighbours checked in increasing index order: up, left, right, down.
+            size_t last = rowCount * colCount;
+            if (r > 0 && board.getType(r - 1, c) == Type::NONE) last = tree - colCount;
+            if (c > 0 && board.getType(r, c - 1) == Type::NONE) last = tree - 1;
+            if (c + 1 < colCount && board.getType(r, c + 1) == Type::NONE) last = tree + 1;
+            if (r + 1 < rowCount && board.getType(r + 1, c) == Type::NONE) last = tree + colCount;
+
+            if (last == rowCount * colCount) {
+                if (treeCounts[tree] == 0)
+                    deadTrees++;
+            } else {
+                finalizeAt[last].push_back(tree);
+            }
+            if (treeCounts[tree] >= 2)
+                overloadedTrees++;
+        }
+    }
+
+    const std::vector<size_t>& currentRow = board.getCurrentRowTents();
+    const std::vector<size_t>& currentCol = board.getCurrentColTents();
+    rowTerm.assign(rowCount, 0);
+    colTerm.assign(colCount, 0);
+    for (size_t r = 0; r < rowCount; r++) {
+        rowTerm[r] = lineTerm(currentRow[r], board.getRowTentNum()[r], remainingRow[r]);
+        rowBound += rowTerm[r];
+    }
+    for (size_t c = 0; c < colCount; c++) {
+        colTerm[c] = lineTerm(currentCol[c], board.getColTentNum()[c], remainingCol[c]);
+        colBound += colTerm[c];
+    }
+}
+
+/*
+////////////////////////////////////////////////////
+Bounding
+////////////////////////////////////////////////////
+*/
+
+// Violations a row/col is guaranteed to keep: its excess, plus the shortfall the remaining cells cannot cover.
+size_t ExactSolver::lineTerm(size_t current, size_t target, size_t remaining) const {
+    if (current >= target)
+        return current - target;
+    return target - current > remaining ? target - current - remaining : 0;
+}
+
+void ExactSolver::refreshTerms(size_t r, size_t c) {
+    size_t newRow = lineTerm(board.getCurrentRowTents()[r], board.getRowTentNum()[r], remainingRow[r]);
+    size_t newCol = lineTerm(board.getCurrentColTents()[c], board.getColTentNum()[c], remainingCol[c]);
+    rowBound = rowBound - rowTerm[r] + newRow;
+    colBound = colBound - colTerm[c] + newCol;
+    rowTerm[r] = newRow;
+    colTerm[c] = newCol;
+}
+
+size_t ExactSolver::lowerBound() const {
+    // Tent adjacency and lonely tents can only grow while tents are being added.
+    return board.getTentViolations() + board.getLonelyTentViolations() + overloadedTrees + deadTrees + rowBound + colBound;
+}
+
+/*
+////////////////////////////////////////////////////
+Search
+////////////////////////////////////////////////////
+*/
+
+void ExactSolver::search(size_t k) {
+    if (++nodeCount > nodeLimit) {
+        aborted = true;
+        return;
+    }
+    if (nodeCount % CLOCK_CHECK_NODES == 0 && (stopRequested() || std::chrono::steady_clock::now() >= deadline)) {
+        aborted = true;
+        return;
+    }
+
+    if (k == cells.size()) {
+        if (board.getViolations() < bestViolations) {
+            bestViolations = board.getViolations();
+            bestBoard.cloneFrom(board);
+        }
+        return;
+    }
+
+    size_t cell = cells[k];
+    size_t r = cell / colCount;
+    size_t c = cell % colCount;
+    Coord coord(r, c);
+    const std::vector<uint8_t>& treeCounts = board.getTreeTentCount();
+
+    // Collect the tent options: every free tree, one overloaded tree if any (free pairing), else every paired tree.
+    Option options[6];
+    size_t numOptions = 0;
+    options[numOptions++] = Option{0, 0};
+    const int dr[4] = {-1, 1, 0, 0};
+    const int dc[4] = {0, 0, -1, 1};
+    const char dirs[4] = {'U', 'D', 'L', 'R'};
+    char overloadedDir = 0;
+    char pairedDirs[4];
+    size_t numPaired = 0;
+    bool anyTree = false;
+    for (int d = 0; d < 4; d++) {
+        int nr = static_cast<int>(r) + dr[d], nc = static_cast<int>(c) + dc[d];
+        if (nr < 0 || nc < 0 || nr >= static_cast<int>(rowCount) || nc >= static_cast<int>(colCount))
+            continue;
+        if (board.getType(nr, nc) != Type::TREE)
+            continue;
+        anyTree = true;
+        uint8_t count = treeCounts[nr * colCount + nc];
+        if (count == 0)
+            options[numOptions++] = Option{dirs[d], 0};
+        else if (count >= 2)
+            overloadedDir = dirs[d];
+        else
+            pairedDirs[numPaired++] = dirs[d];
+    }
+    if (overloadedDir != 0) {
+        options[numOptions++] = Option{overloadedDir, 0};
+    } else {
+        for (size_t p = 0; p < numPaired; p++)
+            options[numOptions++] = Option{pairedDirs[p], 0};
+    }
+    if (!anyTree)
+        options[numOptions++] = Option{'X', 0};
+
+    // Most promising decision first so good incumbents show up early.
+    for (size_t o = 1; o < numOptions; o++)
+        options[o].delta = board.deltaAdd(coord, options[o].dir).total();
+    std::stable_sort(options, options + numOptions, [](const Option &a, const Option &b) {
+        return a.delta < b.delta;
+    });
+
+    size_t oldRowTerm = rowTerm[r];
+    size_t oldColTerm = colTerm[c];
+    remainingRow[r]--;
+    remainingCol[c]--;
+
+    for (size_t o = 0; o < numOptions && !aborted && bestViolations > 0; o++) {
+        char dir = options[o].dir;
+        bool overloads = false;
+        if (dir != 0) {
+            // Pairing with a tree that already has exactly one tent overloads it for good.
+            if (dir != 'X') {
+                size_t tree = dir == 'U' ? cell - colCount : (dir == 'D' ? cell + colCount : (dir == 'L' ? cell - 1 : cell + 1));
+                overloads = treeCounts[tree] == 1;
+            }
+            board.placeTent(coord, dir);
+            if (overloads)
+                overloadedTrees++;
+        }
+        refreshTerms(r, c);
+
+        size_t newlyDead = 0;
+        for (size_t tree : finalizeAt[cell]) {
+            if (treeCounts[tree] == 0)
+                newlyDead++;
+        }
+        deadTrees += newlyDead;
+
+        if (lowerBound() < bestViolations)
+            search(k + 1);
+
+        deadTrees -= newlyDead;
+        if (dir != 0) {
+            board.deleteTent(coord);
+            if (overloads)
+                overloadedTrees--;
+        }
+    }
+
+    remainingRow[r]++;
+    remainingCol[c]++;
+    rowBound = rowBound - rowTerm[r] + oldRowTerm;
+    colBound = colBound - colTerm[c] + oldColTerm;
+    rowTerm[r] = oldRowTerm;
+    colTerm[c] = oldColTerm;
+}
+
+/*
+////////////////////////////////////////////////////
+Running and Output
+////////////////////////////////////////////////////
+*/
+
+bool ExactSolver::run() {
+    if (timeLimitSeconds > 0.0)
+        deadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+
+    // Incumbent: matching seed polished by a short anneal, so the bound prunes from the first node.
+    Board seeded = TentMatcher(board).buildBoard();
+    Annealer annealer(filePath, seeded, 2.0, 0.05, 0.0, 1);
+    for (double temperature : {1.0, 0.5, 0.2, 0.1, 0.05})
+        annealer.run(board.getNumTiles() * 20, temperature);
+    if (annealer.getBestViolations() < bestViolations) {
+        bestBoard.cloneFrom(annealer.getBestBoard());
+        bestViolations = bestBoard.getViolations();
+    }
+
+    if (lowerBound() < bestViolations)
+        search(0);
+
+    optimal = !aborted;
+    return optimal;
+}
+
+size_t ExactSolver::solve() {
+    run();
+    if (!quiet)
+        std::cout << "exact: " << nodeCount << " nodes, best " << bestViolations << (optimal ? " (optimal)" : " (limit reached)") << std::endl;
+    if (optimal)
+        writeSolutionAsync(filePath, bestBoard);
+    return bestViolations;
+}
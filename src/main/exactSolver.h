@@ -0,0 +1,99 @@
+#pragma once
+
+#include "board.h"
+
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Exact branch-and-bound solver for small boards
+ * Decides every open cell in row-major order (empty, or a tent paired with one of its trees) on a single Board,
+ * and prunes with a lower bound that only counts violations no later decision can remove: touching and lonely
+ * tents, overloaded trees, trees whose last candidate cell is decided, and row/col quotas that can no longer
+ * be met with the cells left. The incumbent comes from the matching seed polished by a short anneal.
+ */
+class ExactSolver {
+    public:
+    // Boards up to this many cells are tried here first by main; the node or time limit can still stop the proof,
+    // in which case the heuristics carry on from the incumbent
+    static constexpr size_t MAX_EXACT_TILES = 4096;
+    static constexpr size_t DEFAULT_NODE_LIMIT = 5000000;
+
+    ExactSolver(char * filePath, const Board& board, size_t nodeLimit = DEFAULT_NODE_LIMIT);
+
+    /**
+     * @brief Runs the search without writing anything
+     * @return true if the best board is proven optimal, false if a limit or a stop request cut the search short
+     */
+    bool run();
+
+    /**
+     * @brief Wall-clock limit for run(), checked with stopRequested() every few thousand nodes; 0 leaves only the node limit
+     */
+    void setTimeLimit(double seconds) { timeLimitSeconds = seconds; }
+
+    /**
+     * @brief Runs the search and writes the best board as output once it is proven optimal
+     * A search cut short writes nothing, its incumbent is left to getBestBoard for the caller.
+     * @return best number of violations found
+     */
+    size_t solve();
+
+    /**
+     * @brief Leaves out the summary line solve prints, for --quiet
+     */
+    void setQuiet(bool enabled) { quiet = enabled; }
+
+    bool isOptimal() const { return optimal; }
+    size_t getNodeCount() const { return nodeCount; }
+    size_t getBestViolations() const { return bestViolations; }
+    const Board& getBestBoard() const { return bestBoard; }
+
+    private:
+
+    // Nodes between two looks at the clock and the stop flag
+    static constexpr size_t CLOCK_CHECK_NODES = 4096;
+
+    // One way to decide a cell: no tent when dir is 0, otherwise a tent pointing dir
+    struct Option {
+        char dir;
+        int delta;
+    };
+
+    char * filePath;
+    Board board;
+    Board bestBoard;
+    size_t bestViolations;
+    size_t nodeLimit;
+    size_t nodeCount = 0;
+    double timeLimitSeconds = 0.0;
+    bool quiet = false;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    bool aborted = false;
+    bool optimal = false;
+
+    size_t rowCount;
+    size_t colCount;
+
+    // Open cells in decision order
+    std::vector<size_t> cells;
+
+    // Trees that lose their last undecided candidate cell once a cell is decided
+    std::vector<std::vector<size_t>> finalizeAt;
+
+    // Undecided open cells left in every row/col and the bound each row/col contributes
+    std::vector<size_t> remainingRow;
+    std::vector<size_t> remainingCol;
+    std::vector<size_t> rowTerm;
+    std::vector<size_t> colTerm;
+    size_t rowBound = 0;
+    size_t colBound = 0;
+
+    size_t overloadedTrees = 0; // Trees with two or more tents, a violation no addition can fix
+    size_t deadTrees = 0;       // Trees with no tent and no undecided candidate cell
+
+    size_t lowerBound() const;
+    size_t lineTerm(size_t current, size_t target, size_t remaining) const;
+    void refreshTerms(size_t r, size_t c);
+    void search(size_t k);
+};
@@ -1,38 +1,68 @@
 #include "input.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <stdexcept>
+#include <charconv>
+#include <string_view>
+#include "mappedFile.h"
+
+// Same characters std::istringstream skips between numbers
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Splits off the next line (without its '\n'), a missing line reads as empty
+static std::string_view nextLine(std::string_view& text) {
+    size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    return line;
+}
+
+// Reads the next whitespace-separated unsigned integer from line, false if there is none
+static bool nextNumber(std::string_view& line, size_t& value) {
+    size_t start = 0;
+    while (start < line.size() && isSpace(line[start]))
+        start++;
+    const char* first = line.data() + start;
+    const char* last = line.data() + line.size();
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec != std::errc())
+        return false;
+    line.remove_prefix(ptr - line.data());
+    return true;
+}
+
+static bool onlySpaces(std::string_view line) {
+    for (char c : line) {
+        if (!isSpace(c))
+            return false;
+    }
+    return true;
+}
 
 Board Input::inputFromFile(std::string fileName) {
     
     rowTents.clear();
     columnTents.clear();
-    boardTiles.clear();
+    boardCells.clear();
+    numTrees = 0;
 
-    std::ifstream file(fileName);
+    MappedFile file(fileName);
 
-    if (!file) {
+    if (!file.isOpen()) {
         throw std::runtime_error("Invalid input: rows and columns must be positive integers");
     }
 
-    std::string line;
-    std::vector<std::string> lines;
-
-    while (std::getline(file, line)) {
-        lines.push_back(line);
-    }
+    std::string_view text = file.view();
+    std::string_view line = nextLine(text);
 
-    std::istringstream iss1(lines[0]);
-
-    // Try to read two numbers from the stream.
-    if (!(iss1 >> rows >> columns)) {
+    // Try to read two numbers from the line.
+    if (!nextNumber(line, rows) || !nextNumber(line, columns)) {
         throw std::runtime_error("Invalid input: R and C must be positive integers");
     }
 
     // Ensure that there are no extra characters (other than whitespace) after the numbers.
-    std::string extra1;
-    if (iss1 >> extra1) {
+    if (!onlySpaces(line)) {
         throw std::runtime_error("Invalid input: extra characters detected after R and C");
     }
 
@@ -42,16 +72,17 @@ Board Input::inputFromFile(std::string fileName) {
     }
 
     // Check if R * C is greater than 10^5, which would be invalid.
-    if (rows * columns > 100000) {
+    if (rows > 100000 || columns > 100000 || rows * columns > 100000) {
         throw std::runtime_error("Invalid input: R * C exceeds 10^5");
     }
 
     // rowTents
-    std::istringstream iss2(lines[1]);
+    line = nextLine(text);
     size_t tempNum;
+    rowTents.reserve(rows);
 
     for (size_t i = 0; i < rows; ++i) {
-        if (!(iss2 >> tempNum)) {
+        if (!nextNumber(line, tempNum)) {
             throw std::runtime_error("Invalid input: r_i value must be a non-negative integer");
         }
 
@@ -63,10 +94,11 @@ Board Input::inputFromFile(std::string fileName) {
     }
 
     // columnTents
-    std::istringstream iss3(lines[2]);
+    line = nextLine(text);
+    columnTents.reserve(columns);
 
     for (size_t i = 0; i < columns; ++i) {
-        if (!(iss3 >> tempNum)) {
+        if (!nextNumber(line, tempNum)) {
             throw std::runtime_error("Invalid input: c_i value must be a non-negative integer");
         }
 
@@ -77,26 +109,29 @@ Board Input::inputFromFile(std::string fileName) {
         columnTents.push_back(tempNum);
     }
 
+    // Grid rows go straight into the flat cell array, anything past column C is ignored.
+    boardCells.resize(rows * columns);
     for (size_t i = 0; i < rows; ++i) {
-        std::vector<Tile> tempVector;
+        line = nextLine(text);
+        if (line.size() < columns) {
+            throw std::runtime_error("Invalid input: Tile is not '.' or 'T'");
+        }
+        uint8_t* rowCells = boardCells.data() + i * columns;
         for (size_t j = 0; j < columns; ++j) {
-            if (lines[i+3][j] == '.') {
-                tempVector.push_back(Tile(Type::NONE, i, j));
+            if (line[j] == '.') {
+                rowCells[j] = static_cast<uint8_t>(Type::NONE);
             }
-            else if (lines[i+3][j] == 'T') {
-                tempVector.push_back(Tile(Type::TREE, i, j));
+            else if (line[j] == 'T') {
+                rowCells[j] = static_cast<uint8_t>(Type::TREE);
                 ++numTrees;
             }
             else {
                 throw std::runtime_error("Invalid input: Tile is not '.' or 'T'");
             }
         }
-        boardTiles.push_back(tempVector);
     }
 
-    file.close();
-
-    return Board(rows, columns, rowTents, columnTents, boardTiles, numTrees);
+    return Board(rows, columns, rowTents, columnTents, boardCells);
 }
 
 
@@ -116,7 +151,7 @@ void Input::testOutput() {
 
     for (size_t i = 0; i < rows; ++i) {
         for (size_t j = 0; j < columns; ++j) {
-            std::cout << (int)(boardTiles[i][j].getType());
+            std::cout << (int)boardCells[i * columns + j];
         }
         std::cout << '\n';
     }
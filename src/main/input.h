@@ -6,6 +6,11 @@
 #include <string>
 #include <vector>
 
+/**
+ * @brief Parser for .test files
+ * The file is memory-mapped and scanned in place: counts are read with std::from_chars and the grid is written
+ * straight into the flat cell array the Board is built from, so no per-line strings or Tile grid are created.
+ */
 class Input {
 public:
     Board inputFromFile(std::string fileName);
@@ -17,7 +22,7 @@ private:
     size_t numTrees = 0;
     std::vector<size_t> rowTents;
     std::vector<size_t> columnTents;
-    std::vector<std::vector<Tile>> boardTiles;
+    std::vector<uint8_t> boardCells; // One Type per cell, row-major
 };
 
 #endif
@@ -4,8 +4,25 @@
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <optional>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <cstdint>
 #include "input.h"
 #include "ttsolver.h"
+#include "annealer.h"
+#include "parallelTempering.h"
+#include "tentMatcher.h"
+#include "exactSolver.h"
+#include "clusterSolver.h"
+#include "output.h"
+#include "progressReporter.h"
+#include "snapshot.h"
+#include "stopSignal.h"
+#include "warmStart.h"
+#include "batchScheduler.h"
+#include <omp.h>
 
 void test(char* filePath, Board board);
 
@@ -24,36 +41,267 @@ struct Result {
     double score;
 };
 
+struct Options {
+    bool anneal = false;           // --anneal: simulated annealing instead of the genetic solver
+    bool tempering = false;        // --tempering: parallel tempering, one annealing replica per thread
+    size_t replicas = 0;           // --replicas=<n>: number of tempering replicas, 0 uses every OpenMP thread
+    bool exact = true;             // --no-exact: never hand small boards to the exact solver
+    bool clusters = false;         // --clusters: solve independent tree clusters in parallel before the main engine
+    TTSolver::Crossover crossover = TTSolver::Crossover::ONE_POINT; // --crossover=<one-point|two-point|uniform|rows|rect>
+    double sharingRadius = 0.0;    // --sharing=<cells>: fitness sharing radius in differing cells, 0 is off
+    bool crowding = false;         // --crowding: deterministic crowding replacement in the genetic solver
+    bool steadyState = false;      // --steady: steady-state genetic solver, children replace members in place
+    bool targeted = true;          // --no-targeted: uniform mutations only, no violation-guided repairs
+    size_t pairing = 10;           // --pairing=<n>: re-pair every board's tents with their trees every n generations, 0 = off
+    bool islandModel = false;      // --islands: genetic solver split into islands that breed without a shared barrier
+    size_t islands = 0;            // --islands=<n>: number of islands, 0 uses every OpenMP thread
+    TTSolver::Topology topology = TTSolver::Topology::RING; // --migration=<ring|random>
+    bool quiet = false;            // --quiet: no progress lines at all
+    size_t progressInterval = 1000; // --progress=<ms>: time between progress lines on stderr
+    ProgressReporter::Format progressFormat = ProgressReporter::Format::TEXT; // --progress-json: one JSON object per line
+    bool draw = false;             // --draw: render the best board once the genetic solver finishes
+    double snapshotInterval = 60.0; // --snapshot=<seconds>: checkpoint the genetic population this often, 0 = off
+    bool resume = false;           // --resume: start the genetic solver from the input's last snapshot
+    std::string resumeFile;        // --resume=<file>: start from this snapshot or .out file instead
+    size_t warmStart = 0;          // --warm[=<k>]: seed from the k best earlier .out files (default 8), only write improvements
+    double timeLimit = 60.0;       // --time=<seconds>: length of one scheduler round, whatever the engine; 0 = unlimited, ignored with --evals
+    double budget = 0.0;           // --budget=<seconds>: wall-clock time for the whole batch, 0 runs until solved or stopped
+    size_t threads = 0;            // --threads=<n>: threads shared by all inputs, 0 uses every OpenMP thread
+    size_t evaluations = 0;        // --evals=<n>: per round, children bred by the genetic solver or moves per annealing chain
+    std::optional<uint64_t> seed;  // --seed=<n>: reproducible rounds given the same threads and --evals, round k uses n + k
+    double startTemperature = 2.0; // --t0=<temperature>
+    double endTemperature = 0.02;  // --t1=<temperature>
+};
+
 void clFlags(Input* input, const std::string& clArg) {
     if (clArg == "--parse") {
         input->testOutput();
     }
 }
 
+void parseOption(Options& options, const std::string& clArg) {
+    if (clArg == "--anneal") {
+        options.anneal = true;
+    } else if (clArg == "--tempering") {
+        options.tempering = true;
+    } else if (clArg == "--no-exact") {
+        options.exact = false;
+    } else if (clArg == "--clusters") {
+        options.clusters = true;
+    } else if (clArg.rfind("--crossover=", 0) == 0) {
+        std::string kind = clArg.substr(12);
+        if (kind == "one-point") options.crossover = TTSolver::Crossover::ONE_POINT;
+        else if (kind == "two-point") options.crossover = TTSolver::Crossover::TWO_POINT;
+        else if (kind == "uniform") options.crossover = TTSolver::Crossover::UNIFORM;
+        else if (kind == "rows") options.crossover = TTSolver::Crossover::ROW_BLOCK;
+        else if (kind == "rect") options.crossover = TTSolver::Crossover::RECTANGLE;
+        else std::cerr << "Unknown crossover " << kind << ", keeping one-point" << std::endl;
+    } else if (clArg.rfind("--sharing=", 0) == 0) {
+        options.sharingRadius = std::stod(clArg.substr(10));
+    } else if (clArg == "--crowding") {
+        options.crowding = true;
+    } else if (clArg == "--steady") {
+        options.steadyState = true;
+    } else if (clArg == "--no-targeted") {
+        options.targeted = false;
+    } else if (clArg.rfind("--pairing=", 0) == 0) {
+        options.pairing = std::stoul(clArg.substr(10));
+    } else if (clArg == "--islands") {
+        options.islandModel = true;
+    } else if (clArg.rfind("--islands=", 0) == 0) {
+        options.islandModel = true;
+        options.islands = std::stoul(clArg.substr(10));
+    } else if (clArg.rfind("--migration=", 0) == 0) {
+        std::string kind = clArg.substr(12);
+        if (kind == "ring") options.topology = TTSolver::Topology::RING;
+        else if (kind == "random") options.topology = TTSolver::Topology::RANDOM;
+        else std::cerr << "Unknown migration topology " << kind << ", keeping ring" << std::endl;
+    } else if (clArg == "--quiet") {
+        options.quiet = true;
+    } else if (clArg.rfind("--progress=", 0) == 0) {
+        options.progressInterval = std::max<size_t>(std::stoul(clArg.substr(11)), 1);
+    } else if (clArg == "--progress-json") {
+        options.progressFormat = ProgressReporter::Format::JSON;
+    } else if (clArg == "--draw") {
+        options.draw = true;
+    } else if (clArg.rfind("--snapshot=", 0) == 0) {
+        options.snapshotInterval = std::stod(clArg.substr(11));
+    } else if (clArg == "--warm") {
+        options.warmStart = 8;
+    } else if (clArg.rfind("--warm=", 0) == 0) {
+        options.warmStart = std::stoul(clArg.substr(7));
+    } else if (clArg == "--resume") {
+        options.resume = true;
+    } else if (clArg.rfind("--resume=", 0) == 0) {
+        options.resume = true;
+        options.resumeFile = clArg.substr(9);
+    } else if (clArg.rfind("--replicas=", 0) == 0) {
+        options.replicas = std::stoul(clArg.substr(11));
+    } else if (clArg.rfind("--budget=", 0) == 0) {
+        options.budget = std::stod(clArg.substr(9));
+    } else if (clArg.rfind("--threads=", 0) == 0) {
+        options.threads = std::stoul(clArg.substr(10));
+    } else if (clArg.rfind("--evals=", 0) == 0) {
+        options.evaluations = std::stoull(clArg.substr(8));
+    } else if (clArg.rfind("--seed=", 0) == 0) {
+        options.seed = std::stoull(clArg.substr(7));
+    } else if (clArg.rfind("--time=", 0) == 0) {
+        options.timeLimit = std::stod(clArg.substr(7));
+    } else if (clArg.rfind("--t0=", 0) == 0) {
+        options.startTemperature = std::stod(clArg.substr(5));
+    } else if (clArg.rfind("--t1=", 0) == 0) {
+        options.endTemperature = std::stod(clArg.substr(5));
+    }
+}
+
+// One scheduler round: the engine options pick, started from the best board the instance has so far.
+BatchScheduler::Round runRound(const Options& options, BatchScheduler::Instance& instance, double seconds) {
+    char* path = instance.path.data();
+    Board board = instance.input;
+    uint64_t seed = options.seed ? *options.seed + instance.rounds : std::random_device{}();
+    // The first round reads earlier runs back from disk, later rounds start from the best board so far.
+    // The write gate goes up before any engine runs, the exact solver included.
+    std::vector<Board> seeds;
+    if (instance.rounds > 0) {
+        seeds.push_back(instance.best);
+    } else if (options.warmStart > 0) {
+        WarmStart warm = WarmStart::load(path, board, options.warmStart);
+        // With nothing on disk yet the first board written sets the bar, later rounds only add improvements.
+        keepImprovementsOnly(path, warm.boards.empty() ? std::numeric_limits<size_t>::max() : warm.boards[0].getViolations());
+        if (!warm.boards.empty() && !options.quiet)
+            std::cerr << path << " warm start: best " << warm.boards[0].getViolations() << " of "
+                      << warm.scanned << " files (" << warm.rejected << " invalid)" << std::endl;
+        seeds = std::move(warm.boards);
+    }
+
+    if (options.exact && instance.rounds == 0 && board.getNumTiles() <= ExactSolver::MAX_EXACT_TILES) {
+        // Small boards skip the heuristics entirely once the search proves its answer, the search is only worth one try.
+        // The search shares the round's time, a board it cannot finish must not hold up the rest of the batch.
+        ExactSolver exactSolver(path, board);
+        exactSolver.setQuiet(options.quiet);
+        exactSolver.setTimeLimit(seconds);
+        auto start = std::chrono::steady_clock::now();
+        exactSolver.solve();
+        if (exactSolver.isOptimal())
+            return {exactSolver.getBestBoard(), true};
+        // Cut short by a limit, its incumbent seeds the heuristics instead of being thrown away.
+        // Seeds stay best first, the local search engines only look at the first one.
+        size_t violations = exactSolver.getBestViolations();
+        auto worse = std::find_if(seeds.begin(), seeds.end(), [&](const Board& other) { return other.getViolations() > violations; });
+        seeds.insert(worse, exactSolver.getBestBoard());
+        if (seconds > 0.0) {
+            seconds -= std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            // The search used up the round, the next one starts the heuristics from the best seed.
+            if (seconds <= 0.0 || stopRequested())
+                return {seeds[0]};
+        }
+    }
+
+    if (options.clusters) {
+        // On its own the coordinator is the engine, otherwise it only seeds the local search.
+        bool seedOnly = options.tempering || options.anneal;
+        // An unlimited round still has to hand the local search its seed at some point.
+        double reconcile = seconds > 0.0 ? seconds : Options{}.timeLimit;
+        ClusterSolver clusterSolver(board, static_cast<unsigned>(seed));
+        clusterSolver.setQuiet(options.quiet);
+        board = clusterSolver.solve(seedOnly ? reconcile / 4 : seconds);
+        if (!seedOnly) {
+            writeSolutionAsync(path, board);
+            return {board};
+        }
+    } else if (options.tempering || options.anneal) {
+        // Local search starts from the matching seed rather than the empty board.
+        board = TentMatcher(board).buildBoard();
+    }
+    if ((options.tempering || options.anneal) && !seeds.empty() && seeds[0].getViolations() < board.getViolations())
+        board.cloneFrom(seeds[0]);
+
+    if (options.tempering) {
+        size_t replicas = options.replicas > 0 ? options.replicas : static_cast<size_t>(omp_get_max_threads());
+        ParallelTempering tempering(path, board, replicas, options.endTemperature, options.startTemperature, seconds, static_cast<unsigned>(seed));
+        tempering.setMoveLimit(options.evaluations);
+        tempering.setQuiet(options.quiet);
+        tempering.solve();
+        return {tempering.getBestBoard()};
+    }
+    if (options.anneal) {
+        Annealer annealer(path, board, options.startTemperature, options.endTemperature, seconds, static_cast<unsigned>(seed));
+        annealer.setMoveLimit(options.evaluations);
+        annealer.setQuiet(options.quiet);
+        annealer.solve();
+        return {annealer.getBestBoard()};
+    }
+
+    TTSolver solver(path, 100, 50, board, 1, 0, 0, 13, 40);
+    solver.setCrossover(options.crossover);
+    solver.setSharingRadius(options.sharingRadius);
+    solver.setCrowding(options.crowding);
+    solver.setSteadyState(options.steadyState);
+    solver.setTargetedMutation(options.targeted);
+    solver.setPairingInterval(options.pairing);
+    if (options.islandModel) {
+        size_t islands = options.islands > 0 ? options.islands : static_cast<size_t>(omp_get_max_threads());
+        solver.setIslands(islands, options.topology);
+    }
+    std::optional<ProgressReporter> reporter;
+    if (!options.quiet)
+        reporter.emplace(std::cerr, std::chrono::milliseconds(options.progressInterval), options.progressFormat, path);
+    solver.setProgress(reporter ? &*reporter : nullptr);
+    solver.setDrawBest(options.draw);
+    solver.setSeeds(std::move(seeds));
+    solver.setTimeLimit(seconds);
+    solver.setEvaluationLimit(options.evaluations);
+    solver.setSeed(seed);
+    std::filesystem::path snapshotPath = Snapshot::pathFor(path);
+    if (options.snapshotInterval > 0.0) {
+        std::error_code error;
+        std::filesystem::create_directories(snapshotPath.parent_path(), error);
+        solver.setSnapshots(snapshotPath, options.snapshotInterval);
+    }
+    if (options.resume && instance.rounds == 0)
+        solver.setResume(options.resumeFile.empty() ? snapshotPath.string() : options.resumeFile);
+    solver.solve();
+    return {solver.getBestBoard()};
+}
+
 int main(int argc, char** argv) {
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <file1> [file2 ...] [options]" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <file or directory> [...] [options]" << std::endl;
+        std::cerr << "Options: --anneal --tempering --replicas=<n> --no-exact --clusters --crossover=<kind> --sharing=<cells> --crowding --steady --no-targeted --pairing=<n> --islands[=<n>] --migration=<ring|random> --quiet --progress=<ms> --progress-json --draw --snapshot=<seconds> --resume[=<file>] --warm[=<k>] --budget=<seconds> --threads=<n> --evals=<n> --seed=<n> --time=<seconds> --t0=<temperature> --t1=<temperature>" << std::endl;
         return 1;
     }
 
-    // Separate file paths and command-line options (those starting with "--")
-    for (int i = 0; i < 10000; ++i){
-        for (int i = 1; i < argc; ++i) {
-            std::string arg = argv[i];
-            if (arg.rfind("--", 0) == 0) {
-                
-            } else {
-                Input inputData;
-                Board board = inputData.inputFromFile(argv[i]);
-                TTSolver solver(argv[i], 100, 50, board, 1, 0, 0, 13, 40);
-                solver.solve();
-            }
-        }
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) == 0)
+            parseOption(options, arg);
+    }
+
+    // Ctrl-C stops the running rounds early, their best boards and snapshots are still written
+    installStopHandlers();
+
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).rfind("--", 0) != 0)
+            paths.push_back(argv[i]);
     }
 
+    size_t threads = options.threads > 0 ? options.threads : static_cast<size_t>(omp_get_max_threads());
+    BatchScheduler scheduler(BatchScheduler::collectInputs(paths), options.budget, options.timeLimit, threads);
+    scheduler.run([&options](BatchScheduler::Instance& instance, double seconds) {
+        return runRound(options, instance, seconds);
+    });
+
+    if (!options.quiet) {
+        for (const BatchScheduler::Instance& instance : scheduler.getInstances())
+            std::cerr << instance.path << ": best " << instance.best.getViolations() << " after " << instance.rounds
+                      << " rounds in " << instance.seconds << " s" << (instance.solved ? ", solved" : "") << std::endl;
+    }
 
     //test(argv[1], board);
 
+    flushSolutions();
     return 0;
 }
 
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Read-only mapping of a whole file, unmapped on destruction
+ * Empty files are not mapped and read as an empty view.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& fileName) {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0)
+            return;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+            opened = true;
+            size = static_cast<size_t>(info.st_size);
+            if (size > 0) {
+                void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED) {
+                    opened = false;
+                    size = 0;
+                } else {
+                    data = static_cast<const char*>(mapped);
+                    madvise(mapped, size, MADV_SEQUENTIAL);
+                }
+            }
+        }
+        close(fd);
+    }
+
+    ~MappedFile() {
+        if (data != nullptr)
+            munmap(const_cast<char*>(data), size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool isOpen() const { return opened; }
+    std::string_view view() const { return data == nullptr ? std::string_view() : std::string_view(data, size); }
+
+private:
+    const char* data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+};
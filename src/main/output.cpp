@@ -0,0 +1,263 @@
+#include "output.h"
+
+#include <random>
+#include <iostream>
+#include <string>
+#include <filesystem>
+#include <optional>
+#include <charconv>
+#include <limits>
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+
+/*
+/////////////////////////////////////////////////////////////////////////////
+Formatting and atomic writes
+/////////////////////////////////////////////////////////////////////////////
+*/
+
+void formatSolution(const Board& board, std::string& buffer) {
+    const TilesSet &tentTiles = board.getTentTilesData();
+
+    // Longest possible line is two full size_t values, two spaces, a direction and a newline.
+    constexpr size_t DIGITS = std::numeric_limits<size_t>::digits10 + 1;
+    buffer.resize(2 * (DIGITS + 1) + tentTiles.size() * (2 * DIGITS + 4));
+    char* out = buffer.data();
+    char* end = buffer.data() + buffer.size();
+
+    auto number = [&](size_t value, char after) {
+        out = std::to_chars(out, end, value).ptr;
+        *out++ = after;
+    };
+
+    number(board.getViolations(), '\n');
+    number(tentTiles.size(), '\n');
+    for (size_t i = 0; i < tentTiles.size(); i++) {
+        Coord tent = *tentTiles.getTileAtIndex(i);
+        number(tent.getRow() + 1, ' ');
+        number(tent.getCol() + 1, ' ');
+        *out++ = board.getDir(tent.getRow(), tent.getCol());
+        *out++ = '\n';
+    }
+
+    buffer.resize(out - buffer.data());
+}
+
+bool writeFileAtomic(const std::filesystem::path& path, const std::string& data) {
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error opening file for writing: " << tempPath << std::endl;
+        return false;
+    }
+
+    // One write normally covers the whole buffer, the loop only handles short writes.
+    const char* next = data.data();
+    size_t left = data.size();
+    while (left > 0) {
+        ssize_t written = ::write(fd, next, left);
+        if (written < 0) {
+            std::cerr << "Error writing " << tempPath << std::endl;
+            ::close(fd);
+            ::unlink(tempPath.c_str());
+            return false;
+        }
+        next += written;
+        left -= static_cast<size_t>(written);
+    }
+
+    bool synced = ::fdatasync(fd) == 0;
+    if (::close(fd) != 0 || !synced || std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error finishing " << path << std::endl;
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::filesystem::path outputDirectory(const char* inputFilePath) {
+    std::filesystem::path inputPath(inputFilePath);
+    return inputPath.parent_path() / (inputPath.stem().string() + "_output");
+}
+
+// Creates the output folder if needed and picks a fresh file name in it.
+static std::optional<std::filesystem::path> solutionPath(const char* inputFilePath) {
+
+    std::string baseName = std::filesystem::path(inputFilePath).stem().string();
+    std::filesystem::path outputFolderPath = outputDirectory(inputFilePath);
+
+    // Make new output folder
+    std::error_code error;
+    std::filesystem::create_directories(outputFolderPath, error);
+    if (error) {
+        std::cerr << "Error creating output directory: " << outputFolderPath << std::endl;
+        return std::nullopt;
+    }
+
+    // random number for name
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> dis(1, 999999);
+    int randomIndex = dis(gen);
+
+    return outputFolderPath / (baseName + '_' + std::to_string(randomIndex) + ".out");
+}
+
+bool writeSolution(const char* inputFilePath, const Board& board) {
+    std::optional<std::filesystem::path> path = solutionPath(inputFilePath);
+    if (!path)
+        return false;
+
+    std::string buffer;
+    formatSolution(board, buffer);
+    return writeFileAtomic(*path, buffer);
+}
+
+/*
+/////////////////////////////////////////////////////////////////////////////
+Background writer
+/////////////////////////////////////////////////////////////////////////////
+*/
+
+namespace {
+    /**
+     * @brief One thread that drains a queue of files to write atomically, started on first use
+     * Written buffers go back to a free list, so a solver that keeps writing stops allocating after the first few.
+     */
+    class FileWriter {
+        public:
+        ~FileWriter() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            if (worker.joinable())
+                worker.join();
+        }
+
+        // A recycled buffer for the caller to fill, empty when none is free.
+        std::string spareBuffer() {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (spare.empty())
+                return std::string();
+            std::string buffer = std::move(spare.back());
+            spare.pop_back();
+            return buffer;
+        }
+
+        void submit(const std::filesystem::path& path, std::string data, bool replaceQueued) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto queued = std::find_if(jobs.begin(), jobs.end(), [&](const Job& job) { return job.path == path; });
+                if (replaceQueued && queued != jobs.end()) {
+                    std::swap(queued->data, data);
+                    recycle(std::move(data));
+                } else {
+                    jobs.push_back({path, std::move(data)});
+                }
+                if (!worker.joinable())
+                    worker = std::thread(&FileWriter::run, this);
+            }
+            wake.notify_all();
+        }
+
+        void flush() {
+            std::unique_lock<std::mutex> lock(mutex);
+            drained.wait(lock, [this] { return jobs.empty() && !busy; });
+        }
+
+        private:
+        // Enough for a solution and a snapshot in flight, snapshots of big boards run to megabytes each
+        static constexpr size_t MAX_SPARE = 4;
+
+        struct Job {
+            std::filesystem::path path;
+            std::string data;
+        };
+
+        // Called with the mutex held.
+        void recycle(std::string buffer) {
+            if (spare.size() < MAX_SPARE)
+                spare.push_back(std::move(buffer));
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty())
+                    return;
+
+                Job job = std::move(jobs.front());
+                jobs.pop_front();
+                busy = true;
+                lock.unlock();
+
+                writeFileAtomic(job.path, job.data);
+
+                lock.lock();
+                busy = false;
+                recycle(std::move(job.data));
+                if (jobs.empty())
+                    drained.notify_all();
+            }
+        }
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        std::deque<Job> jobs;
+        std::vector<std::string> spare;
+        bool busy = false;
+        bool stopping = false;
+        std::thread worker;
+    };
+
+    FileWriter fileWriter;
+
+    // Per input, the violations a new solution has to beat, see keepImprovementsOnly
+    std::mutex barMutex;
+    std::unordered_map<std::string, size_t> bars;
+}
+
+void keepImprovementsOnly(const char* inputFilePath, size_t bestViolations) {
+    std::lock_guard<std::mutex> lock(barMutex);
+    bars[inputFilePath] = bestViolations;
+}
+
+void writeSolutionAsync(const char* inputFilePath, const Board& board) {
+    {
+        std::lock_guard<std::mutex> lock(barMutex);
+        auto bar = bars.find(inputFilePath);
+        if (bar != bars.end()) {
+            if (board.getViolations() >= bar->second)
+                return;
+            bar->second = board.getViolations();
+        }
+    }
+    std::optional<std::filesystem::path> path = solutionPath(inputFilePath);
+    if (!path)
+        return;
+    // Formatting happens on the caller's thread, the board is only read here.
+    std::string buffer = fileWriter.spareBuffer();
+    formatSolution(board, buffer);
+    fileWriter.submit(*path, std::move(buffer), false);
+}
+
+void writeFileAsync(const std::filesystem::path& path, std::string data) {
+    fileWriter.submit(path, std::move(data), true);
+}
+
+void flushSolutions() {
+    fileWriter.flush();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "board.h"
+
+#include <filesystem>
+#include <string>
+
+/**
+ * @brief Formats a board in the Algobowl output format: violations, number of tents, then one "row col dir" line
+ * per tent (1 indexed). buffer is overwritten and keeps its capacity, so a reused buffer never reallocates.
+ */
+void formatSolution(const Board& board, std::string& buffer);
+
+/**
+ * @brief Writes data to a temporary file next to path with a single write, syncs it and renames it over path
+ * Readers see either the old file or the complete new one, never a partial write.
+ * @return true if the file was written
+ */
+bool writeFileAtomic(const std::filesystem::path& path, const std::string& data);
+
+/**
+ * @brief <input dir>/<input name>_output, where the solution files and snapshots of an input go
+ */
+std::filesystem::path outputDirectory(const char* inputFilePath);
+
+/**
+ * @brief Writes a board as a solution file next to its input
+ * The file goes to <input dir>/<input name>_output/<input name>_<random>.out, see formatSolution and writeFileAtomic.
+ * @return true if the file was written
+ */
+bool writeSolution(const char* inputFilePath, const Board& board);
+
+/**
+ * @brief writeSolution on a background thread, the board is formatted before returning so it may change right after
+ */
+void writeSolutionAsync(const char* inputFilePath, const Board& board);
+
+/**
+ * @brief From now on writeSolutionAsync drops boards of inputFilePath that do not strictly beat bestViolations
+ * Each solution it does write lowers the bar again, so repeated runs only add files that improve on the best stored one.
+ */
+void keepImprovementsOnly(const char* inputFilePath, size_t bestViolations);
+
+/**
+ * @brief writeFileAtomic on the background writer, replacing a queued write to the same path that has not started yet
+ * Used for files that are rewritten periodically, where only the newest version matters.
+ */
+void writeFileAsync(const std::filesystem::path& path, std::string data);
+
+/**
+ * @brief Blocks until every file queued by writeSolutionAsync or writeFileAsync is on disk
+ */
+void flushSolutions();
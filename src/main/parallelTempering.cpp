@@ -0,0 +1,124 @@
+#include "parallelTempering.h"
+#include "output.h"
+#include "stopSignal.h"
+#include <omp.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+ParallelTempering::ParallelTempering(char * filePath, const Board& board, size_t numReplicas, double minTemperature, double maxTemperature, double timeLimitSeconds, unsigned seed)
+    : filePath(filePath),
+      numReplicas(std::max<size_t>(numReplicas, 1)),
+      timeLimitSeconds(timeLimitSeconds),
+      seed(seed),
+      globalBest(board),
+      globalBestViolations(board.getViolations())
+{
+    replicas.reserve(this->numReplicas);
+    for (size_t i = 0; i < this->numReplicas; i++) {
+        replicas.emplace_back(filePath, board, maxTemperature, minTemperature, timeLimitSeconds, seed + static_cast<unsigned>(i));
+    }
+
+    for (size_t i = 0; i < this->numReplicas; i++) {
+        double fraction = this->numReplicas > 1 ? static_cast<double>(i) / (this->numReplicas - 1) : 0.0;
+        ladder.push_back(minTemperature * std::pow(maxTemperature / minTemperature, fraction));
+        replicaOnRung.push_back(i);
+    }
+}
+
+void ParallelTempering::publishBest(Annealer& replica) {
+    // Cheap check first, the lock is only taken when this replica may actually improve the shared best.
+    if (replica.getBestViolations() >= globalBestViolations.load(std::memory_order_relaxed))
+        return;
+
+    const Board& best = replica.getBestBoard();
+    std::lock_guard<std::mutex> lock(globalBestMutex);
+    if (best.getViolations() < globalBestViolations.load(std::memory_order_relaxed)) {
+        globalBest.cloneFrom(best);
+        globalBestViolations.store(best.getViolations(), std::memory_order_relaxed);
+    }
+}
+
+void ParallelTempering::exchange(size_t round, std::mt19937 &gen) {
+    std::uniform_real_distribution<double> unitDist(0.0, 1.0);
+
+    for (size_t rung = round % 2; rung + 1 < numReplicas; rung += 2) {
+        Annealer& cold = replicas[replicaOnRung[rung]];
+        Annealer& hot = replicas[replicaOnRung[rung + 1]];
+
+        // Metropolis criterion for swapping the two configurations between temperatures.
+        double energyGap = static_cast<double>(cold.getViolations()) - static_cast<double>(hot.getViolations());
+        double exponent = (1.0 / ladder[rung] - 1.0 / ladder[rung + 1]) * energyGap;
+        exchangeAttempts++;
+        if (exponent >= 0.0 || unitDist(gen) < std::exp(exponent)) {
+            std::swap(replicaOnRung[rung], replicaOnRung[rung + 1]);
+            exchangeAccepts++;
+        }
+    }
+}
+
+size_t ParallelTempering::temper() {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    // Replica i runs on seed + i, the exchanges take the next seed along
+    std::mt19937 exchangeGen(seed + static_cast<unsigned>(numReplicas));
+
+    std::vector<size_t> rungOfReplica(numReplicas);
+    for (size_t rung = 0; rung < numReplicas; rung++)
+        rungOfReplica[replicaOnRung[rung]] = rung;
+    bool done = false;
+    size_t round = 0;
+    elapsed = 0.0;
+
+    #pragma omp parallel num_threads(static_cast<int>(numReplicas))
+    {
+        size_t id = static_cast<size_t>(omp_get_thread_num());
+
+        while (!done) {
+            // Each thread drives the replicas with its id, so extra replicas still run when fewer threads are granted.
+            for (size_t replica = id; replica < numReplicas; replica += static_cast<size_t>(omp_get_num_threads())) {
+                replicas[replica].run(MOVES_PER_EXCHANGE, ladder[rungOfReplica[replica]]);
+                publishBest(replicas[replica]);
+            }
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                exchange(round++, exchangeGen);
+                for (size_t rung = 0; rung < numReplicas; rung++)
+                    rungOfReplica[replicaOnRung[rung]] = rung;
+
+                elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                bool outOfBudget = moveLimit > 0 ? round * MOVES_PER_EXCHANGE >= moveLimit
+                    : timeLimitSeconds > 0.0 && elapsed >= timeLimitSeconds;
+                done = outOfBudget || globalBestViolations.load() == 0 || stopRequested();
+            }
+        }
+    }
+
+    return globalBestViolations.load();
+}
+
+size_t ParallelTempering::solve() {
+    temper();
+    writeSolutionAsync(filePath, globalBest);
+    if (quiet)
+        return globalBestViolations.load();
+
+    std::vector<size_t> rungOfReplica(numReplicas);
+    for (size_t rung = 0; rung < numReplicas; rung++)
+        rungOfReplica[replicaOnRung[rung]] = rung;
+    size_t totalMoves = 0;
+    for (size_t i = 0; i < numReplicas; i++) {
+        totalMoves += replicas[i].getMoveCount();
+        std::cout << "replica " << i << ": T=" << ladder[rungOfReplica[i]] << ", "
+                  << static_cast<size_t>(replicas[i].getMoveCount() / std::max(elapsed, 1e-9)) << " moves/s, best "
+                  << replicas[i].getBestViolations() << std::endl;
+    }
+    std::cout << "tempering: " << numReplicas << " replicas, " << totalMoves << " moves in " << elapsed << " s ("
+              << static_cast<size_t>(totalMoves / std::max(elapsed, 1e-9) / numReplicas) << " moves/s per thread), "
+              << exchangeAccepts << "/" << exchangeAttempts << " swaps accepted, best " << globalBestViolations.load() << std::endl;
+    return globalBestViolations.load();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "board.h"
+#include "annealer.h"
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <random>
+
+/**
+ * @brief Replica-exchange (parallel tempering) solver built on Annealer chains
+ * Every OpenMP thread owns one replica running at its own temperature. After each batch of moves the
+ * replicas on neighbouring rungs of the temperature ladder swap temperatures with the Metropolis criterion,
+ * and any replica that beats the shared best-so-far publishes a snapshot of its best board.
+ */
+class ParallelTempering {
+    public:
+    /**
+     * @brief Construct a new ParallelTempering object
+     * The ladder is geometric between minTemperature and maxTemperature with one rung per replica.
+     */
+    ParallelTempering(char * filePath, const Board& board, size_t numReplicas, double minTemperature, double maxTemperature, double timeLimitSeconds, unsigned seed = std::random_device{}());
+
+    /**
+     * @brief Runs every replica until the time budget runs out or a perfect board is found, then writes the output
+     * @return best number of violations found
+     */
+    size_t solve();
+
+    /**
+     * @brief Runs the ladder like solve without printing or writing anything
+     * @return best number of violations found
+     */
+    size_t temper();
+
+    /**
+     * @brief Best board any replica has published
+     */
+    const Board& getBestBoard() const { return globalBest; }
+
+    /**
+     * @brief Temperature of every rung, coldest first; exchanges never change it, only which replica runs where
+     */
+    const std::vector<double>& getLadder() const { return ladder; }
+    const std::vector<size_t>& getReplicaOnRung() const { return replicaOnRung; }
+    Annealer& getReplica(size_t index) { return replicas[index]; }
+    size_t getExchangeAccepts() const { return exchangeAccepts; }
+    size_t getExchangeAttempts() const { return exchangeAttempts; }
+    double getElapsed() const { return elapsed; }
+
+    /**
+     * @brief Stops after about this many moves per replica, 0 for no limit; the time limit is ignored while it is set
+     * Replicas only meet at exchange rounds, so a seeded run that stops on moves ends with the same violations.
+     */
+    void setMoveLimit(size_t movesPerReplica) { moveLimit = movesPerReplica; }
+
+    /**
+     * @brief Leaves out the per-replica and summary lines solve prints, for --quiet
+     */
+    void setQuiet(bool enabled) { quiet = enabled; }
+
+    // Moves each replica performs between two exchange rounds, large enough to keep the barrier cheap
+    static constexpr size_t MOVES_PER_EXCHANGE = 20000;
+
+    private:
+
+    char * filePath;
+    size_t numReplicas;
+    double timeLimitSeconds;
+    size_t moveLimit = 0;
+    bool quiet = false;
+    unsigned seed;
+    double elapsed = 0.0;
+
+    std::vector<Annealer> replicas;
+    std::vector<double> ladder;           // Temperature of every rung, coldest first
+    std::vector<size_t> replicaOnRung;    // Which replica currently runs at each rung
+
+    Board globalBest;
+    std::atomic<size_t> globalBestViolations;
+    std::mutex globalBestMutex;
+
+    size_t exchangeAttempts = 0;
+    size_t exchangeAccepts = 0;
+
+    /**
+     * @brief Publishes a replica's best board if it beats the shared best
+     */
+    void publishBest(Annealer&);
+
+    /**
+     * @brief Attempts temperature swaps between neighbouring rungs, alternating even and odd pairs each round
+     */
+    void exchange(size_t round, std::mt19937 &gen);
+};
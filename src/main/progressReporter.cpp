@@ -0,0 +1,81 @@
+#include "progressReporter.h"
+
+#include <sstream>
+#include <iomanip>
+
+ProgressReporter::ProgressReporter(std::ostream& out, std::chrono::milliseconds interval, Format format, std::string label)
+    : out(out), interval(interval), format(format), label(std::move(label)), start(std::chrono::steady_clock::now()) {
+    worker = std::thread(&ProgressReporter::run, this);
+}
+
+ProgressReporter::~ProgressReporter() {
+    {
+        std::lock_guard<std::mutex> lock(stopMutex);
+        stopping = true;
+    }
+    stopSignal.notify_one();
+    worker.join();
+}
+
+void ProgressReporter::publish(size_t gen, size_t bestViolations, size_t evals, double meanDistance) {
+    generation.store(gen, std::memory_order_relaxed);
+    best.store(bestViolations, std::memory_order_relaxed);
+    // Islands publish their own running totals, a late thread must not pull the count back down.
+    size_t seen = evaluations.load(std::memory_order_relaxed);
+    while (evals > seen && !evaluations.compare_exchange_weak(seen, evals, std::memory_order_relaxed)) {}
+    diversity.store(meanDistance, std::memory_order_relaxed);
+    published.store(true, std::memory_order_release);
+}
+
+void ProgressReporter::run() {
+    auto last = start;
+    size_t lastEvaluations = 0;
+    std::unique_lock<std::mutex> lock(stopMutex);
+    bool done = false;
+    while (!done) {
+        // Wakes early only to write the final line.
+        done = stopSignal.wait_for(lock, interval, [this] { return stopping; });
+
+        if (!published.load(std::memory_order_acquire))
+            continue;
+
+        auto now = std::chrono::steady_clock::now();
+        size_t evals = evaluations.load(std::memory_order_relaxed);
+        double elapsed = std::chrono::duration<double>(now - last).count();
+        double rate = elapsed > 0.0 && evals > lastEvaluations ? (evals - lastEvaluations) / elapsed : 0.0;
+        report(std::chrono::duration<double>(now - start).count(), rate);
+        last = now;
+        lastEvaluations = evals;
+    }
+}
+
+void ProgressReporter::report(double seconds, double rate) {
+    double meanDistance = diversity.load(std::memory_order_relaxed);
+
+    // One write per line, so lines from other threads never interleave with it.
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1);
+    if (format == Format::JSON) {
+        line << "{\"label\":\"";
+        for (char ch : label) {
+            if (ch == '"' || ch == '\\')
+                line << '\\';
+            line << ch;
+        }
+        line << "\",\"generation\":" << generation.load(std::memory_order_relaxed)
+             << ",\"best\":" << best.load(std::memory_order_relaxed) << ",\"evalsPerSecond\":" << rate
+             << ",\"diversity\":";
+        if (meanDistance < 0.0)
+            line << "null";
+        else
+            line << meanDistance;
+        line << ",\"seconds\":" << seconds << "}\n";
+    } else {
+        line << label << " gen=" << generation.load(std::memory_order_relaxed)
+             << " best=" << best.load(std::memory_order_relaxed) << " evals/s=" << rate;
+        if (meanDistance >= 0.0)
+            line << " diversity=" << meanDistance;
+        line << " t=" << seconds << "s\n";
+    }
+    out << line.str() << std::flush;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Rate-limited progress channel for long solves
+ * The solver only publishes its latest counters into atomics, which costs a few relaxed stores per generation.
+ * A background thread wakes every interval, turns the counters into one compact line (or one JSON object) with
+ * the evaluation rate since the last line, and writes it. Nothing is printed between intervals and the solver
+ * never waits on the stream.
+ */
+class ProgressReporter {
+    public:
+    enum class Format {
+        TEXT,  // label gen=.. best=.. evals/s=.. diversity=.. t=..
+        JSON   // {"label":..,"generation":..,"best":..,"evalsPerSecond":..,"diversity":..,"seconds":..}
+    };
+
+    ProgressReporter(std::ostream& out, std::chrono::milliseconds interval, Format format, std::string label);
+
+    // Stops the thread and writes one final line
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * @brief Latest state of the solve, safe from any thread
+     * @param evaluations total boards (or moves) evaluated so far, the reporter keeps the largest and derives the rate
+     * @param diversity mean pairwise distance of the population, negative if unknown
+     */
+    void publish(size_t generation, size_t best, size_t evaluations, double diversity);
+
+    private:
+    void run();
+    void report(double seconds, double rate);
+
+    std::ostream& out;
+    std::chrono::milliseconds interval;
+    Format format;
+    std::string label;
+
+    std::atomic<size_t> generation{0};
+    std::atomic<size_t> best{0};
+    std::atomic<size_t> evaluations{0};
+    std::atomic<double> diversity{-1.0};
+    // Nothing is reported before the first publish, a zero best would read as solved
+    std::atomic<bool> published{false};
+
+    std::chrono::steady_clock::time_point start;
+    std::mutex stopMutex;
+    std::condition_variable stopSignal;
+    bool stopping = false;
+    std::thread worker;
+};
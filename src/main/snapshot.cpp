@@ -0,0 +1,124 @@
+#include "snapshot.h"
+#include "output.h"
+
+#include <cstring>
+
+static constexpr char MAGIC[8] = {'T', 'T', 'S', 'N', 'A', 'P', '0', '2'};
+
+static uint64_t fnv1a(std::string_view data) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char byte : data) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+static void put(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Reads a T at offset and advances it, false once the data runs out.
+template <typename T>
+static bool take(std::string_view data, size_t& offset, T& value) {
+    if (data.size() - offset < sizeof(T))
+        return false;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+void Snapshot::encode(const std::vector<Board>& boards, uint64_t generation, uint64_t stale, std::string_view randomState, std::string& buffer) {
+    size_t tents = 0;
+    for (const Board& board : boards)
+        tents += board.getTentTilesData().size();
+
+    buffer.clear();
+    buffer.reserve(sizeof(MAGIC) + 44 + randomState.size() + boards.size() * 4 + tents * 5);
+    buffer.append(MAGIC, sizeof(MAGIC));
+    uint32_t cols = boards.empty() ? 0 : static_cast<uint32_t>(boards[0].getNumCols());
+    put<uint32_t>(buffer, boards.empty() ? 0 : static_cast<uint32_t>(boards[0].getNumRows()));
+    put<uint32_t>(buffer, cols);
+    put<uint64_t>(buffer, generation);
+    put<uint64_t>(buffer, stale);
+    put<uint32_t>(buffer, static_cast<uint32_t>(randomState.size()));
+    buffer.append(randomState);
+    put<uint32_t>(buffer, static_cast<uint32_t>(boards.size()));
+
+    for (const Board& board : boards) {
+        const TilesSet& tentTiles = board.getTentTilesData();
+        put<uint32_t>(buffer, static_cast<uint32_t>(tentTiles.size()));
+        for (size_t i = 0; i < tentTiles.size(); i++) {
+            Coord tent = *tentTiles.getTileAtIndex(i);
+            put<uint32_t>(buffer, static_cast<uint32_t>(tent.getRow() * cols + tent.getCol()));
+        }
+        for (size_t i = 0; i < tentTiles.size(); i++) {
+            Coord tent = *tentTiles.getTileAtIndex(i);
+            buffer.push_back(board.getDir(tent.getRow(), tent.getCol()));
+        }
+    }
+
+    put<uint64_t>(buffer, fnv1a(buffer));
+}
+
+bool Snapshot::looksLikeSnapshot(std::string_view data) {
+    return data.size() >= sizeof(MAGIC) && std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::optional<Snapshot> Snapshot::decode(std::string_view data, const Board& startingBoard) {
+    if (!looksLikeSnapshot(data) || data.size() < sizeof(MAGIC) + sizeof(uint64_t))
+        return std::nullopt;
+    uint64_t checksum;
+    std::memcpy(&checksum, data.data() + data.size() - sizeof(uint64_t), sizeof(uint64_t));
+    data.remove_suffix(sizeof(uint64_t));
+    if (fnv1a(data) != checksum)
+        return std::nullopt;
+
+    size_t offset = sizeof(MAGIC);
+    uint32_t rows, cols, length, count;
+    Snapshot snapshot;
+    if (!take(data, offset, rows) || !take(data, offset, cols) || !take(data, offset, snapshot.generation)
+        || !take(data, offset, snapshot.stale) || !take(data, offset, length) || data.size() - offset < length)
+        return std::nullopt;
+    snapshot.randomState = data.substr(offset, length);
+    offset += length;
+    if (!take(data, offset, count))
+        return std::nullopt;
+    if (rows != startingBoard.getNumRows() || cols != startingBoard.getNumCols())
+        return std::nullopt;
+
+    // Trees and targets come from the input, any tents it carries are dropped first.
+    Board empty = startingBoard;
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (empty.getType(r, c) == Type::TENT)
+                empty.deleteTent(Coord(r, c));
+        }
+    }
+
+    snapshot.boards.reserve(count);
+    for (uint32_t b = 0; b < count; b++) {
+        uint32_t tents;
+        if (!take(data, offset, tents) || (data.size() - offset) / 5 < tents)
+            return std::nullopt;
+        const char* indices = data.data() + offset;
+        const char* dirs = indices + size_t(tents) * sizeof(uint32_t);
+        offset += size_t(tents) * 5;
+
+        Board& board = snapshot.boards.emplace_back(empty);
+        for (uint32_t t = 0; t < tents; t++) {
+            uint32_t index;
+            std::memcpy(&index, indices + size_t(t) * sizeof(uint32_t), sizeof(uint32_t));
+            if (index >= size_t(rows) * cols || !board.placeTent(Coord(index / cols, index % cols), dirs[t]))
+                return std::nullopt;
+        }
+    }
+    if (offset != data.size())
+        return std::nullopt;
+    return snapshot;
+}
+
+std::filesystem::path Snapshot::pathFor(const char* inputFilePath) {
+    return outputDirectory(inputFilePath) / (std::filesystem::path(inputFilePath).stem().string() + ".snap");
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "board.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Compact binary checkpoint of a genetic solver population
+ * Layout (native endianness, the file never leaves the machine that wrote it):
+ *   "TTSNAP02", uint32 rows, uint32 cols, uint64 generation, uint64 stale, uint32 length, length x char
+ *   random state (std::mt19937_64 text form, may be empty), uint32 boards,
+ *   per board: uint32 tents, tents x uint32 cell index (row * cols + col), tents x char direction,
+ *   then a uint64 FNV-1a checksum of everything before it.
+ * Only tents are stored, trees and targets come from the input, so a 250x400 board costs about 5 bytes a tent.
+ */
+struct Snapshot {
+    uint64_t generation = 0;   // Generations bred when the snapshot was taken
+    uint64_t stale = 0;        // Generations since the best board last improved
+    std::string randomState;   // Solver seeder as written by operator<<, a resumed seeded run continues its sequence
+    std::vector<Board> boards;
+
+    /**
+     * @brief Encodes boards into buffer, replacing its contents
+     */
+    static void encode(const std::vector<Board>& boards, uint64_t generation, uint64_t stale, std::string_view randomState, std::string& buffer);
+
+    /**
+     * @brief Rebuilds the boards on top of startingBoard's trees and targets
+     * @return std::nullopt if data is not a snapshot of this input or is damaged
+     */
+    static std::optional<Snapshot> decode(std::string_view data, const Board& startingBoard);
+
+    /**
+     * @brief True if data starts like a snapshot, used to tell snapshots from .out files
+     */
+    static bool looksLikeSnapshot(std::string_view data);
+
+    /**
+     * @brief <input dir>/<input name>_output/<input name>.snap, next to the solution files
+     */
+    static std::filesystem::path pathFor(const char* inputFilePath);
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread
+ * Head and tail live on separate cache lines and each side keeps a cached copy of the other's index, so the
+ * shared atomics are only reread when the queue looks full or empty. Neither call ever blocks.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+    /**
+     * @brief Copies value into the queue, producer side only
+     * @return false if the queue is full
+     */
+    bool tryPush(const T& value) {
+        std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail - headCache == Capacity) {
+            headCache = headIndex.load(std::memory_order_acquire);
+            if (tail - headCache == Capacity)
+                return false;
+        }
+        slots[tail & (Capacity - 1)] = value;
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves the oldest element into value, consumer side only
+     * @return false if the queue is empty
+     */
+    bool tryPop(T& value) {
+        std::size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head == tailCache) {
+            tailCache = tailIndex.load(std::memory_order_acquire);
+            if (head == tailCache)
+                return false;
+        }
+        value = std::move(*slots[head & (Capacity - 1)]);
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    private:
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> headIndex{0};
+    std::size_t tailCache = 0;
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> tailIndex{0};
+    std::size_t headCache = 0;
+
+    // Slots start empty since T need not be default constructible, a popped slot keeps its moved-from value
+    alignas(64) std::array<std::optional<T>, Capacity> slots;
+};
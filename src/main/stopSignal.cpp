@@ -0,0 +1,28 @@
+#include "stopSignal.h"
+
+#include <atomic>
+#include <csignal>
+
+static std::atomic<bool> stopFlag{false};
+static_assert(std::atomic<bool>::is_always_lock_free, "the stop flag is written from a signal handler");
+
+static void onStopSignal(int signal) {
+    // A second Ctrl-C means the user is done waiting.
+    if (stopFlag.exchange(true, std::memory_order_relaxed)) {
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+}
+
+void installStopHandlers() {
+    std::signal(SIGINT, onStopSignal);
+    std::signal(SIGTERM, onStopSignal);
+}
+
+bool stopRequested() {
+    return stopFlag.load(std::memory_order_relaxed);
+}
+
+void requestStop(bool stop) {
+    stopFlag.store(stop, std::memory_order_relaxed);
+}
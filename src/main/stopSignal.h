@@ -0,0 +1,18 @@
+#pragma once
+
+/**
+ * @brief Graceful shutdown on SIGINT / SIGTERM
+ * The first signal only raises a flag: solvers poll stopRequested() between generations or move batches, stop,
+ * and write their best board and snapshot as if their budget had run out. A second signal terminates at once.
+ */
+void installStopHandlers();
+
+/**
+ * @brief True once SIGINT or SIGTERM arrived (or requestStop was called), a single relaxed atomic load
+ */
+bool stopRequested();
+
+/**
+ * @brief Raises the same flag as a signal, and clears it again with false (for tests and batch drivers)
+ */
+void requestStop(bool stop = true);
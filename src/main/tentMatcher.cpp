@@ -0,0 +1,178 @@
+#include "tentMatcher.h"
+
+#include <algorithm>
+#include <limits>
+
+TentMatcher::TentMatcher(const Board& board) : startingBoard(board) {
+    buildGraph();
+    hopcroftKarp();
+}
+
+void TentMatcher::buildGraph() {
+    size_t rows = startingBoard.getNumRows();
+    size_t cols = startingBoard.getNumCols();
+    const std::vector<size_t>& rowTentNum = startingBoard.getRowTentNum();
+    const std::vector<size_t>& colTentNum = startingBoard.getColTentNum();
+
+    // Number every open cell that could hold a tent for some tree.
+    std::vector<int> candidateId(rows * cols, UNMATCHED);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            if (startingBoard.getType(r, c) == Type::TREE)
+                trees.push_back(r * cols + c);
+        }
+    }
+
+    treeStart.reserve(trees.size() + 1);
+    treeStart.push_back(0);
+    for (size_t tree : trees) {
+        size_t r = tree / cols;
+        size_t c = tree % cols;
+        size_t neighbours[4];
+        size_t numNeighbours = 0;
+        if (r > 0) neighbours[numNeighbours++] = tree - cols;
+        if (r + 1 < rows) neighbours[numNeighbours++] = tree + cols;
+        if (c > 0) neighbours[numNeighbours++] = tree - 1;
+        if (c + 1 < cols) neighbours[numNeighbours++] = tree + 1;
+
+        for (size_t k = 0; k < numNeighbours; k++) {
+            size_t cell = neighbours[k];
+            size_t cr = cell / cols;
+            size_t cc = cell % cols;
+            if (startingBoard.getType(cr, cc) != Type::NONE || rowTentNum[cr] == 0 || colTentNum[cc] == 0)
+                continue;
+            if (candidateId[cell] == UNMATCHED) {
+                candidateId[cell] = static_cast<int>(candidates.size());
+                candidates.push_back(cell);
+            }
+            treeAdj.push_back(candidateId[cell]);
+        }
+        treeStart.push_back(treeAdj.size());
+    }
+
+    matchTree.assign(trees.size(), UNMATCHED);
+    matchCandidate.assign(candidates.size(), UNMATCHED);
+}
+
+// BFS from every free tree, dist holds the layer of every tree reachable through alternating paths.
+bool TentMatcher::layerTrees(std::vector<int>& dist) const {
+    constexpr int INF = std::numeric_limits<int>::max();
+    std::vector<int> queue;
+    queue.reserve(trees.size());
+
+    for (size_t t = 0; t < trees.size(); t++) {
+        if (matchTree[t] == UNMATCHED) {
+            dist[t] = 0;
+            queue.push_back(static_cast<int>(t));
+        } else {
+            dist[t] = INF;
+        }
+    }
+
+    bool foundFree = false;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int t = queue[head];
+        for (size_t e = treeStart[t]; e < treeStart[t + 1]; e++) {
+            int owner = matchCandidate[treeAdj[e]];
+            if (owner == UNMATCHED) {
+                foundFree = true;
+            } else if (dist[owner] == INF) {
+                dist[owner] = dist[t] + 1;
+                queue.push_back(owner);
+            }
+        }
+    }
+    return foundFree;
+}
+
+// Iterative DFS along the BFS layers, flipping the path when it reaches a free candidate.
+bool TentMatcher::augment(int root, std::vector<int>& dist, std::vector<size_t>& next) {
+    constexpr int INF = std::numeric_limits<int>::max();
+    std::vector<int> stack = {root};
+
+    while (!stack.empty()) {
+        int t = stack.back();
+        if (next[t] == treeStart[t + 1]) {
+            // Dead end, never visit this tree again in this phase.
+            dist[t] = INF;
+            stack.pop_back();
+            continue;
+        }
+
+        int candidate = treeAdj[next[t]];
+        int owner = matchCandidate[candidate];
+        if (owner == UNMATCHED) {
+            for (int t2 : stack) {
+                int c2 = treeAdj[next[t2]];
+                matchTree[t2] = c2;
+                matchCandidate[c2] = t2;
+            }
+            return true;
+        }
+        if (dist[owner] == dist[t] + 1)
+            stack.push_back(owner);
+        else
+            next[t]++;
+    }
+    return false;
+}
+
+void TentMatcher::hopcroftKarp() {
+    std::vector<int> dist(trees.size());
+    std::vector<size_t> next(trees.size());
+
+    while (layerTrees(dist)) {
+        for (size_t t = 0; t < trees.size(); t++)
+            next[t] = treeStart[t];
+        for (size_t t = 0; t < trees.size(); t++) {
+            if (matchTree[t] == UNMATCHED && augment(static_cast<int>(t), dist, next))
+                matchingSize++;
+        }
+    }
+}
+
+Board TentMatcher::buildBoard(std::mt19937 *gen) const {
+    Board board = startingBoard;
+    size_t cols = startingBoard.getNumCols();
+
+    std::vector<size_t> order(trees.size());
+    for (size_t t = 0; t < trees.size(); t++)
+        order[t] = t;
+    if (gen != nullptr)
+        std::shuffle(order.begin(), order.end(), *gen);
+
+    for (size_t t : order) {
+        if (matchTree[t] == UNMATCHED)
+            continue;
+
+        size_t tree = trees[t];
+        // The matched cell is tried first, the tree's other candidates are fallbacks when it got blocked.
+        Coord bestCell;
+        char bestDir = 'X';
+        int bestDelta = 0;
+        auto consider = [&](int candidate) {
+            size_t cell = candidates[candidate];
+            size_t r = cell / cols;
+            size_t c = cell % cols;
+            if (board.getType(r, c) != Type::NONE)
+                return;
+            char dir = tree + cols == cell ? 'U' : (cell + cols == tree ? 'D' : (tree + 1 == cell ? 'L' : 'R'));
+            int delta = board.deltaAdd(Coord(r, c), dir).total();
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestCell = Coord(r, c);
+                bestDir = dir;
+            }
+        };
+
+        consider(matchTree[t]);
+        if (bestDelta == 0) {
+            for (size_t e = treeStart[t]; e < treeStart[t + 1]; e++)
+                consider(treeAdj[e]);
+        }
+        if (bestDelta < 0)
+            board.placeTent(bestCell, bestDir);
+    }
+
+    return board;
+}
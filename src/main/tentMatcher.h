@@ -0,0 +1,54 @@
+#pragma once
+
+#include "board.h"
+
+#include <vector>
+#include <random>
+
+/**
+ * @brief Constructive seeding through a maximum tree-tent matching
+ * Builds the bipartite graph between trees and the open, orthogonally adjacent cells that lie in rows and
+ * columns with a non-zero quota, and computes a maximum matching with Hopcroft–Karp. The matching is then
+ * laid onto a Board tree by tree, keeping only placements that lower the violation count, so touching tents
+ * and full rows/columns are skipped in favour of the tree's other candidate cells.
+ */
+class TentMatcher {
+    public:
+    /**
+     * @brief Builds the graph and runs Hopcroft–Karp, O(E * sqrt(V))
+     */
+    explicit TentMatcher(const Board& board);
+
+    /**
+     * @brief Emits the starting board with the matched tents placed and associated with their trees
+     * @param gen when given, trees are laid down in a random order so repeated calls give different boards
+     */
+    Board buildBoard(std::mt19937 *gen = nullptr) const;
+
+    /**
+     * @brief Number of trees matched to a candidate cell
+     */
+    size_t getMatchingSize() const { return matchingSize; }
+
+    private:
+    static constexpr int UNMATCHED = -1;
+
+    const Board& startingBoard;
+
+    // Left side: trees, right side: candidate tent cells, both as linear cell indices
+    std::vector<size_t> trees;
+    std::vector<size_t> candidates;
+
+    // Candidate cells of every tree in compressed rows: candidates[treeAdj[treeStart[t]...treeStart[t + 1]]]
+    std::vector<size_t> treeStart;
+    std::vector<int> treeAdj;
+
+    std::vector<int> matchTree;      // Candidate matched to every tree
+    std::vector<int> matchCandidate; // Tree matched to every candidate
+    size_t matchingSize = 0;
+
+    void buildGraph();
+    void hopcroftKarp();
+    bool layerTrees(std::vector<int>& dist) const;
+    bool augment(int root, std::vector<int>& dist, std::vector<size_t>& next);
+};
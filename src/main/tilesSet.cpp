@@ -1,45 +1,58 @@
 #include "tilesSet.h"
 #include <optional>
 
-TilesSet::TilesSet(){
-    tiles.reserve(250*400);
+TilesSet::TilesSet(size_t rows, size_t cols) {
+    reset(rows, cols);
+}
+
+TilesSet::TilesSet(const TilesSet& other) : colCount(other.colCount), positions(other.positions) {
+    members.reserve(other.positions.size());
+    members = other.members;
+}
+
+void TilesSet::reset(size_t rows, size_t cols) {
+    colCount = cols;
+    members.clear();
+    members.reserve(rows * cols);
+    positions.assign(rows * cols, ABSENT);
 }
 
 bool TilesSet::insert(const Coord c){
-    if (tileIndex.find(c) != tileIndex.end())
-                return false; // Tile already open.
-            tiles.push_back(std::move(c));
-            tileIndex[c] = tiles.size() - 1;
-            return true;
+    uint32_t id = idOf(c);
+    if (positions[id] != ABSENT)
+        return false; // Tile already in the set.
+    positions[id] = static_cast<uint32_t>(members.size());
+    members.push_back(id);
+    return true;
 }
 
 bool TilesSet::remove(const Coord c) {
-    auto it = tileIndex.find(c);
-    if (it == tileIndex.end())
+    uint32_t id = idOf(c);
+    uint32_t idx = positions[id];
+    if (idx == ABSENT)
         return false; // Tile not found.
 
-    size_t idx = it->second;
-    // Swap with the last tile.
-    Coord lastTile = tiles.back();
-    tiles[idx] = lastTile;
-    tileIndex[lastTile] = idx;
-    
-    // Remove the last tile.
-    tiles.pop_back();
-    tileIndex.erase(it);
+    // Move the last member into the freed slot.
+    uint32_t last = members.back();
+    members[idx] = last;
+    positions[last] = idx;
+
+    members.pop_back();
+    positions[id] = ABSENT;
     return true;
 }
 
 std::optional<Coord> TilesSet::getTileAtIndex(size_t index) const {
-    if (index >= tiles.size())
+    if (index >= members.size())
         return std::nullopt;
-    return std::optional<Coord>{tiles[index]};
+    uint32_t id = members[index];
+    return std::optional<Coord>{Coord(id / colCount, id % colCount)};
 }
 
 bool TilesSet::contains(const Coord &c) const {
-    return tileIndex.count(c) > 0;
+    return positions[idOf(c)] != ABSENT;
 }
 
 size_t TilesSet::size() const {
-    return tiles.size();
-}
\ No newline at end of file
+    return members.size();
+}
@@ -1,33 +1,56 @@
 #pragma once
 #include "coord.h"
+#include <cstdint>
 #include <vector>
-#include <unordered_map>
 #include <optional>
 
+/**
+ * @brief Set of board cells with O(1) insert, remove, membership and uniform sampling by index
+ * A sparse set keyed by the linear cell id row * cols + col: members packs the ids in no particular order and
+ * positions maps every cell of the board to its slot in members. Both are flat arrays sized for the whole board
+ * up front, so nothing is hashed or allocated per operation and copying a set is two memcpys.
+ */
 class TilesSet {
     private:
-        // Vector to store open tiles.
-        std::vector<Coord> tiles;
-        // Map from Coord to its index in the vector.
-        std::unordered_map<Coord, size_t> tileIndex;
-        
+        static constexpr uint32_t ABSENT = UINT32_MAX;
+
+        size_t colCount = 0;
+        // Ids of the cells in the set, packed.
+        std::vector<uint32_t> members;
+        // Slot of each cell in members, ABSENT if the cell is not in the set.
+        std::vector<uint32_t> positions;
+
+        uint32_t idOf(const Coord &c) const { return static_cast<uint32_t>(c.getRow() * colCount + c.getCol()); }
+
     public:
-        TilesSet();
+        TilesSet() = default;
+        // Empty set for a rows x cols board.
+        TilesSet(size_t rows, size_t cols);
+
+        // Keeps room for every cell of the board, so a copy never grows later either.
+        TilesSet(const TilesSet& other);
+        TilesSet(TilesSet&& other) noexcept = default;
+        TilesSet& operator=(const TilesSet& other) = default;
+        TilesSet& operator=(TilesSet&& other) noexcept = default;
+
+        // Empties the set and sizes it for a rows x cols board.
+        void reset(size_t rows, size_t cols);
+
         // Insert a new open tile.
         // Returns true if the tile was added; false if it already exists.
         bool insert(const Coord c);
-        
+
         // Delete an open tile.
         // Returns true if the tile was deleted; false if it was not found.
         bool remove(const Coord c);
-        
-        // Access a tile by index in the vector.
-        // Throws an exception if the index is out of range.
+
+        // Access a tile by index in the packed array.
+        // Returns nullopt if the index is out of range.
         std::optional<Coord> getTileAtIndex(size_t index) const;
-        
-        // Check if a given Coord is an open tile.
+
+        // Check if a given Coord is in the set.
         bool contains(const Coord &c) const;
-        
-        // Returns the number of open tiles.
+
+        // Returns the number of tiles in the set.
         size_t size() const;
-    };
\ No newline at end of file
+    };
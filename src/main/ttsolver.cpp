@@ -1,59 +1,177 @@
 #include "ttsolver.h"
 #include "board.h"
 #include "tilesSet.h"
+#include "output.h"
+#include "tentMatcher.h"
+#include "spscQueue.h"
+#include "snapshot.h"
+#include "stopSignal.h"
+#include "verifier.h"
 #include <omp.h>
 
 #include <random>
 #include <algorithm>
+#include <atomic>
+#include <limits>
 #include <vector>
 #include <iostream>
 #include <string>
 #include <fstream>
-#include <filesystem>
+#include <sstream>
+#include <chrono>
+#include <numeric>
+
+// Longest augmenting path a single mutation searches, in tents
+static constexpr size_t PAIRING_DEPTH = 4;
+
+// Index of the board with the most violations
+static size_t worstIndex(const std::vector<Board>& boards) {
+    return std::max_element(boards.begin(), boards.end(), [](const Board &a, const Board &b) {
+        return a.getViolations() < b.getViolations();
+    }) - boards.begin();
+}
 
-// A single iteration of the solving function
-void TTSolver::iterate() {
+// Index of the board with the fewest violations
+static size_t bestIndex(const std::vector<Board>& boards) {
+    return std::min_element(boards.begin(), boards.end(), [](const Board &a, const Board &b) {
+        return a.getViolations() < b.getViolations();
+    }) - boards.begin();
+}
 
-    //    The best (fewest violations) will be at index 0,1,2,...
-    std::partial_sort(
-        parentGeneration.begin(),
-        parentGeneration.begin() + elitismNum,
-        parentGeneration.end(),
-        [](const Board &a, const Board &b) {
-            return a.getViolations() < b.getViolations();
-        }
-    );
+// A single iteration of the solving function
+size_t TTSolver::iterate() {
 
-    // elitism copies best boards from parentGeneration to currentGeneration
-    for (size_t i = 0; i < elitismNum; i++) {
-        currentGeneration[i] = std::move(parentGeneration[i]);
-    }
+    prepare(population);
 
-    unsigned baseSeed = std::random_device{}();
+    unsigned baseSeed = nextSeed();
 
     #pragma omp parallel
     {
         unsigned seed = baseSeed + omp_get_thread_num();
         std::mt19937 localGen(seed);
 
-        // Fill from 'elitismNum' onward
+        // Fill from the elites onward
         #pragma omp for
-        for (size_t i = elitismNum; i < generationSize; i += 2) {
-            // Perform selection, crossover, and mutation 
-            std::pair<size_t, size_t> parents = selection(localGen);
-            std::pair<Board, Board> children = crossover(parents, localGen);
-            mutation(children, localGen);
+        for (size_t i = population.elites; i < generationSize; i += 2) {
+            Board *secondChild = i + 1 < generationSize ? &population.children[i + 1] : nullptr;
+            std::pair<size_t, size_t> parents = breed(population, population.children[i], secondChild, localGen);
+            if (crowding)
+                crowdingReplace(population, parents, population.children[i], secondChild);
+        }
+    }
 
+    std::swap(population.children, population.parents);
+    return generationSize - std::min(population.elites, generationSize);
+}
+
+// generationSize births into a single population, a child only takes a slot if it has fewer violations
+size_t TTSolver::steadyIterate() {
+
+    repairPairings(population);
+    refreshCaches(population);
+
+    unsigned baseSeed = nextSeed();
+    size_t threads = static_cast<size_t>(omp_get_max_threads());
+    if (scratch.size() != 2 * threads) {
+        scratch.assign(2 * threads, startingBoard);
+        scratchParents.resize(threads);
+    }
+    size_t rounds = std::max<size_t>(generationSize / (2 * threads), 1);
 
-            currentGeneration[i] = std::move(children.first);
-            if (i + 1 < generationSize) {
-                currentGeneration[i + 1] = std::move(children.second);
+    auto compete = [this](Board &child, size_t slot) {
+        if (child.getViolations() < population.parents[slot].getViolations()) {
+            // The replaced board becomes the scratch for a later child, nothing is copied
+            std::swap(child, population.parents[slot]);
+            population.sharedViolations[slot] = population.parents[slot].getViolations() * population.nicheCounts[slot];
+        }
+    };
+
+    #pragma omp parallel
+    {
+        size_t t = omp_get_thread_num();
+        std::mt19937 localGen(baseSeed + t);
+
+        for (size_t round = 0; round < rounds; round++) {
+            // Breeding only reads the population, every thread writes its own two scratch boards
+            scratchParents[t] = breed(population, scratch[2 * t], &scratch[2 * t + 1], localGen);
+
+            #pragma omp barrier
+            #pragma omp single
+            {
+                for (size_t k = 0; k < threads; k++) {
+                    Board &child1 = scratch[2 * k];
+                    Board &child2 = scratch[2 * k + 1];
+                    const std::pair<size_t, size_t>& parents = scratchParents[k];
+                    if (crowding) {
+                        // Each child challenges the parent it is closest to.
+                        const Board& parent1 = population.parents[parents.first];
+                        const Board& parent2 = population.parents[parents.second];
+                        size_t straight = child1.hammingDistance(parent1) + child2.hammingDistance(parent2);
+                        size_t crossed = child1.hammingDistance(parent2) + child2.hammingDistance(parent1);
+                        compete(child1, straight <= crossed ? parents.first : parents.second);
+                        compete(child2, straight <= crossed ? parents.second : parents.first);
+                    } else {
+                        compete(child1, worstIndex(population.parents));
+                        compete(child2, worstIndex(population.parents));
+                    }
+                }
             }
         }
     }
 
-    std::swap(currentGeneration, parentGeneration);
+    return 2 * threads * rounds;
+}
+
+void TTSolver::prepare(Population& pop) {
 
+    repairPairings(pop);
+
+    //    The best (fewest violations) will be at index 0,1,2,...
+    std::partial_sort(
+        pop.parents.begin(),
+        pop.parents.begin() + pop.elites,
+        pop.parents.end(),
+        [](const Board &a, const Board &b) {
+            return a.getViolations() < b.getViolations();
+        }
+    );
+
+    refreshCaches(pop);
+
+    // elitism copies best boards from the parents to the children
+    for (size_t i = 0; i < pop.elites; i++) {
+        pop.children[i].cloneFrom(pop.parents[i]);
+    }
+}
+
+void TTSolver::refreshCaches(Population& pop) {
+    // Every distance this generation reads comes from one pass over the parents.
+    pop.diversity.compute(pop.parents);
+    pop.diversity.nicheCounts(sharingRadius, pop.nicheCounts);
+    pop.sharedViolations.resize(pop.parents.size());
+    for (size_t i = 0; i < pop.parents.size(); i++)
+        pop.sharedViolations[i] = pop.parents[i].getViolations() * pop.nicheCounts[i];
+}
+
+void TTSolver::repairPairings(Population& pop) {
+    size_t generation = pop.generation++;
+    if (pairingInterval == 0 || generation % pairingInterval != 0)
+        return;
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < pop.parents.size(); i++)
+        pop.parents[i].optimisePairing();
+}
+
+std::pair<size_t, size_t> TTSolver::breed(const Population& pop, Board &child1, Board *child2, std::mt19937 &gen) {
+    // Perform selection, crossover, and mutation
+    std::pair<size_t, size_t> parents = selection(pop, gen);
+    crossover(pop, parents, child1, child2, gen);
+
+    mutation(child1, gen);
+    if (child2 != nullptr)
+        mutation(*child2, gen);
+    return parents;
 }
 
 /*
@@ -63,11 +181,11 @@ Runs on every iteration
 */
 
 // Sorting algo for remembering: 
-// std::sort(currentGeneration.begin(), currentGeneration.end(), [](const Board& a, const Board& b){return a.getViolations() < b.getViolations();});
-std::pair<size_t, size_t> TTSolver::selection(std::mt19937 &gen) {
+// std::sort(population.children.begin(), population.children.end(), [](const Board& a, const Board& b){return a.getViolations() < b.getViolations();});
+std::pair<size_t, size_t> TTSolver::selection(const Population& pop, std::mt19937 &gen) {
     std::pair<size_t, size_t> parents1;
     std::pair<size_t, size_t> parents2;
-    std::uniform_int_distribution<size_t> dist(0, parentGeneration.size() - 1);
+    std::uniform_int_distribution<size_t> dist(0, pop.parents.size() - 1);
 
     // First tournament to form the first candidate pair.
     for (int i = 0; i < 2; i++) {
@@ -75,7 +193,7 @@ std::pair<size_t, size_t> TTSolver::selection(std::mt19937 &gen) {
         // Run a mini tournament of size 2 (adjust tournament size as needed)
         for (int j = 0; j < 2; j++){
             size_t index = dist(gen);
-            if (parentGeneration[index].getViolations() < parentGeneration[bestIndex].getViolations())
+            if (pop.sharedViolations[index] < pop.sharedViolations[bestIndex])
                 bestIndex = index;
         }
         if (i == 0)
@@ -89,7 +207,7 @@ std::pair<size_t, size_t> TTSolver::selection(std::mt19937 &gen) {
         size_t bestIndex = dist(gen);
         for (int j = 0; j < 2; j++){
             size_t index = dist(gen);
-            if (parentGeneration[index].getViolations() < parentGeneration[bestIndex].getViolations())
+            if (pop.sharedViolations[index] < pop.sharedViolations[bestIndex])
                 bestIndex = index;
         }
         if (i == 0)
@@ -98,8 +216,8 @@ std::pair<size_t, size_t> TTSolver::selection(std::mt19937 &gen) {
             parents2.second = bestIndex;
     }
 
-    double score1 = weightedPairScore(parentGeneration[parents1.first], parentGeneration[parents1.second]);
-    double score2 = weightedPairScore(parentGeneration[parents2.first], parentGeneration[parents2.second]);
+    double score1 = weightedPairScore(pop, parents1.first, parents1.second);
+    double score2 = weightedPairScore(pop, parents2.first, parents2.second);
 
     // Lower score indicates a better pair.
     if (score1 < score2)
@@ -109,120 +227,275 @@ std::pair<size_t, size_t> TTSolver::selection(std::mt19937 &gen) {
 }
 
 
-double TTSolver::weightedPairScore(const Board &a,const Board &b) {
+double TTSolver::weightedPairScore(const Population& pop, size_t a, size_t b) const {
     // Average the violations of both boards (lower is better)
-    double avgViolations = (a.getViolations() + b.getViolations()) / 2.0;
+    double avgViolations = (pop.parents[a].getViolations() + pop.parents[b].getViolations()) / 2.0;
     // Get the Hamming distance (diversity) between the two boards
-    double diversity = a.countXorBits(b.getBitBoard());
+    double distance = pop.diversity.distance(a, b);
     // Lower score is better, so subtract diversity-weight
-    return (avgViolations/static_cast<double>(numTiles)) - diversityWeight * diversity;
+    return (avgViolations/static_cast<double>(numTiles)) - diversityWeight * distance;
 }
 
-std::pair<Board, Board> TTSolver::crossover(std::pair<size_t, size_t>& parents, std::mt19937 &gen) {
-
-    std::pair<Board, Board> childrenBoards = std::make_pair(parentGeneration[parents.first], parentGeneration[parents.second]);
-
-    // Choose a crossover point
-    std::uniform_int_distribution<size_t> dist(0, numTiles);
-    size_t crossoverPoint = dist(gen);
-
-    size_t tileCount = 0;
-    for (size_t r = 0; r < numRows; r++) {
-        for (size_t c = 0; c < numCols; c++) {
-            if (tileCount >= crossoverPoint) {
-
-                Tile p1Tile = parentGeneration[parents.first].getTile(r, c);
-                Tile p2Tile = parentGeneration[parents.second].getTile(r, c);
-
-                if (childrenBoards.first.getTile(r, c).getType() != p2Tile.getType() || ((childrenBoards.first.getTile(r, c).getType() == Type::TENT && p2Tile.getType() == Type::TENT) && childrenBoards.first.getTile(r, c).getDir() != p2Tile.getDir())) {
-                    childrenBoards.first.setTile(p2Tile, gen);
-                }
-
-                if (childrenBoards.second.getTile(r, c).getType() != p1Tile.getType() || ((childrenBoards.second.getTile(r, c).getType() == Type::TENT && p1Tile.getType() == Type::TENT) && childrenBoards.second.getTile(r, c).getDir() != p1Tile.getDir())) {
-                    childrenBoards.second.setTile(p1Tile, gen);
-                }
-
-            }
-            tileCount++;
-
+void TTSolver::crossover(const Population& pop, std::pair<size_t, size_t>& parents, Board &child1, Board *child2, std::mt19937 &gen) {
+
+    const Board& parent1 = pop.parents[parents.first];
+    const Board& parent2 = pop.parents[parents.second];
+    child1.cloneFrom(parent1);
+    if (child2 != nullptr)
+        child2->cloneFrom(parent2);
+
+    // Each child swaps the region for the other parent's cells, only the cells that differ are touched.
+    auto swapRange = [&](size_t begin, size_t end, const uint64_t* mask) {
+        child1.copyCellsFrom(parent2, begin, end, mask);
+        if (child2 != nullptr)
+            child2->copyCellsFrom(parent1, begin, end, mask);
+    };
+
+    auto pick = [&gen](size_t low, size_t high) {
+        return std::uniform_int_distribution<size_t>(low, high)(gen);
+    };
+
+    switch (crossoverKind) {
+        case Crossover::ONE_POINT: {
+            swapRange(pick(0, numTiles), numTiles, nullptr);
+            break;
+        }
+        case Crossover::TWO_POINT: {
+            size_t a = pick(0, numTiles), b = pick(0, numTiles);
+            swapRange(std::min(a, b), std::max(a, b), nullptr);
+            break;
+        }
+        case Crossover::UNIFORM: {
+            // One bit per cell, kept per thread since children are built in parallel.
+            thread_local std::vector<uint64_t> mask;
+            mask.resize((numTiles + 63) / 64);
+            for (uint64_t& word : mask)
+                word = (static_cast<uint64_t>(gen()) << 32) | gen();
+            swapRange(0, numTiles, mask.data());
+            break;
+        }
+        case Crossover::ROW_BLOCK: {
+            size_t a = pick(0, numRows), b = pick(0, numRows);
+            swapRange(std::min(a, b) * numCols, std::max(a, b) * numCols, nullptr);
+            break;
+        }
+        case Crossover::RECTANGLE: {
+            size_t r0 = pick(0, numRows), r1 = pick(0, numRows);
+            size_t c0 = pick(0, numCols), c1 = pick(0, numCols);
+            if (r0 > r1) std::swap(r0, r1);
+            if (c0 > c1) std::swap(c0, c1);
+            for (size_t r = r0; r < r1; r++)
+                swapRange(r * numCols + c0, r * numCols + c1, nullptr);
+            break;
         }
     }
-
-    return childrenBoards;
 }
 
-void TTSolver::mutation(std::pair<Board, Board>& children, std::mt19937 &gen) {
+void TTSolver::mutation(Board& board, std::mt19937 &gen) {
     std::uniform_int_distribution<int> chanceDist(0, 100);
 
-    auto& board1 = children.first;
-    auto& board2 = children.second; 
-    
     for (int i = 0; i < std::max((int)initalEmptyTiles/32, 1); i++){
 
         int randValue = chanceDist(gen);
 
         if (randValue <= mutationChance) {
+            if (targetedMutation && (gen() & 1) && repairMutation(board, gen))
+                continue;
+
             std::uniform_int_distribution<> mutationTypeDist(0, 2);
             int mutationType = mutationTypeDist(gen);
 
-            if (mutationType == 0) {
-                if (!board1.addTent(gen))
-                    board1.removeTent(gen);
+            // Every candidate move is evaluated first and only committed if it does not add violations.
+            std::optional<Coord> openTile = board.randomOpenTile(gen);
+            std::optional<Coord> tent = board.randomTent(gen);
+
+            if (mutationType == 0 && !openTile)
+                mutationType = 1;
+            else if (mutationType == 1 && !tent)
+                mutationType = 0;
+
+            if (mutationType == 0 && openTile) {
+                char dir = board.chooseTreeDir(*openTile, gen);
+                if (board.deltaAdd(*openTile, dir).total() <= 0)
+                    board.placeTent(*openTile, dir);
             }
-            else if (mutationType == 1) {
-                if (!board1.removeTent(gen))
-                board1.addTent(gen);
+            else if (mutationType == 1 && tent) {
+                if (board.deltaRemove(*tent).total() <= 0)
+                    board.deleteTent(*tent);
             }
-            else {
-                board1.moveTent(gen);
+            else if (mutationType == 2 && tent && openTile) {
+                char dir = board.chooseTreeDir(*openTile, gen);
+                if (board.deltaMove(*tent, *openTile, dir).total() <= 0)
+                    board.moveTent(*tent, *openTile, dir);
             }
         }
 
     }
 
-    for (int i = 0; i < std::max((int)initalEmptyTiles/32, 1); i++){
-
-        int randValue = chanceDist(gen);
+}
 
-        if (randValue <= mutationChance) {
-            std::uniform_int_distribution<> mutationTypeDist(0, 2);
-            int mutationType = mutationTypeDist(gen);
+bool TTSolver::repairMutation(Board& board, std::mt19937 &gen) {
+    // Pick a conflict kind uniformly among the non-empty sets, so rare kinds still get attention.
+    enum Conflict { OFF_ROW, OFF_COL, TOUCHING, LONELY_TENT, LONELY_TREE };
+    Conflict kinds[5];
+    size_t numKinds = 0;
+    if (board.getOffRows().size() > 0)
+        kinds[numKinds++] = OFF_ROW;
+    if (board.getOffCols().size() > 0)
+        kinds[numKinds++] = OFF_COL;
+    if (board.getTouchingTents().size() > 0)
+        kinds[numKinds++] = TOUCHING;
+    if (board.getLonelyTents().size() > 0)
+        kinds[numKinds++] = LONELY_TENT;
+    if (board.getLonelyTrees().size() > 0)
+        kinds[numKinds++] = LONELY_TREE;
+    if (numKinds == 0)
+        return false;
 
-            if (mutationType == 0) {
-                if (!board2.addTent(gen))
-                    board2.removeTent(gen);
-            }
-            else if (mutationType == 1) {
-                if (!board2.removeTent(gen))
-                    board2.addTent(gen);
-            }
-            else {
-                board2.moveTent(gen);
-            }
+    auto tryAdd = [&](Coord at, char dir) {
+        if (board.deltaAdd(at, dir).total() <= 0)
+            board.placeTent(at, dir);
+    };
+    auto tryRemove = [&](Coord at) {
+        if (board.deltaRemove(at).total() <= 0)
+            board.deleteTent(at);
+    };
+    auto tryMove = [&](Coord from, Coord to, char dir) {
+        if (board.deltaMove(from, to, dir).total() <= 0)
+            board.moveTent(from, to, dir);
+    };
+    // A spot next to a tree that still wants a tent, the tent pointing at it.
+    auto lonelyTreeSpot = [&]() -> std::optional<std::pair<Coord, char>> {
+        std::optional<Coord> tree = board.randomLonelyTree(gen);
+        if (!tree)
+            return std::nullopt;
+        return board.randomSpotBeside(*tree, gen);
+    };
+
+    std::uniform_int_distribution<size_t> kindDist(0, numKinds - 1);
+    Conflict kind = kinds[kindDist(gen)];
+    switch (kind) {
+        case OFF_ROW:
+        case OFF_COL: {
+            bool isRow = kind == OFF_ROW;
+            size_t line = isRow ? *board.randomOffRow(gen) : *board.randomOffCol(gen);
+            size_t current = isRow ? board.getCurrentRowTents()[line] : board.getCurrentColTents()[line];
+            size_t target = isRow ? board.getRowTentNum()[line] : board.getColTentNum()[line];
+            Type wanted = current < target ? Type::NONE : Type::TENT;
+            std::optional<Coord> cell = isRow ? board.randomCellInRow(line, wanted, gen)
+                                              : board.randomCellInCol(line, wanted, gen);
+            if (!cell)
+                return false;
+            if (wanted == Type::NONE)
+                tryAdd(*cell, board.chooseTreeDir(*cell, gen));
+            else
+                tryRemove(*cell);
+            return true;
+        }
+        case TOUCHING: {
+            Coord tent = *board.randomTouchingTent(gen);
+            std::optional<std::pair<Coord, char>> spot = lonelyTreeSpot();
+            if (spot && (gen() & 1))
+                tryMove(tent, spot->first, spot->second);
+            else
+                tryRemove(tent);
+            return true;
         }
+        case LONELY_TENT: {
+            Coord tent = *board.randomLonelyTent(gen);
+            // Re-pairing in place beats moving whenever a short augmenting path exists.
+            if (board.repairPairing(tent, PAIRING_DEPTH))
+                return true;
+            std::optional<std::pair<Coord, char>> spot = lonelyTreeSpot();
+            if (spot)
+                tryMove(tent, spot->first, spot->second);
+            else
+                tryRemove(tent);
+            return true;
+        }
+        case LONELY_TREE: {
+            std::optional<Coord> tree = board.randomLonelyTree(gen);
+            if (board.claimTree(*tree))
+                return true;
+            // Most lonely trees in dense puzzles are boxed in, those leave the draw to a uniform move.
+            std::optional<std::pair<Coord, char>> spot = board.randomSpotBeside(*tree, gen);
+            if (!spot)
+                return false;
+            // Either bring in a tent that is not doing its job elsewhere or pitch a new one.
+            std::optional<Coord> spare = board.randomLonelyTent(gen);
+            if (spare && (gen() & 1))
+                tryMove(*spare, spot->first, spot->second);
+            else
+                tryAdd(spot->first, spot->second);
+            return true;
+        }
+    }
+    return false;
+}
 
+void TTSolver::crowdingReplace(const Population& pop, const std::pair<size_t, size_t>& parents, Board &child1, Board *child2) {
+    const Board& parent1 = pop.parents[parents.first];
+    const Board& parent2 = pop.parents[parents.second];
+
+    // A parent that beats the child it is paired with takes the child's slot back.
+    auto compete = [](Board &child, const Board &parent) {
+        if (parent.getViolations() < child.getViolations())
+            child.cloneFrom(parent);
+    };
+
+    if (child2 == nullptr) {
+        compete(child1, child1.hammingDistance(parent1) <= child1.hammingDistance(parent2) ? parent1 : parent2);
+        return;
     }
 
+    size_t straight = child1.hammingDistance(parent1) + child2->hammingDistance(parent2);
+    size_t crossed = child1.hammingDistance(parent2) + child2->hammingDistance(parent1);
+    compete(child1, straight <= crossed ? parent1 : parent2);
+    compete(*child2, straight <= crossed ? parent2 : parent1);
 }
 
 void TTSolver::initialize(){
     numRows = startingBoard.getNumRows();
     numCols = startingBoard.getNumCols();
     numTiles = numRows * numCols;
-    std::uniform_int_distribution<int> dist(0, static_cast<int>(numTiles)/2);
-    // #pragma omp parallel
-    // {
-    //     // Create a random number generator.
-    //     std::mt19937 gen(std::random_device{}());
-
-    //     #pragma omp for
-    //     for (auto &board : currentGeneration) {
-    //         int randomNumberOfTents = dist(gen);  // Random number of tents between 0% to 50% of numTiles
-    //         for (int i = 0; i < randomNumberOfTents; ++i) {
-    //             board.addTent(gen);
-    //         }
-    //     }
-    // }
+    initalEmptyTiles = startingBoard.getOpenTilesData().size();
+    population.generation = 0;
+    resumedStale = 0;
+
+    // Seed every board from the maximum tree-tent matching, laid down in a different tree order per board.
+    TentMatcher matcher(startingBoard);
+    unsigned baseSeed = nextSeed();
+
+    #pragma omp parallel
+    {
+        std::mt19937 gen(baseSeed + omp_get_thread_num());
+
+        #pragma omp for
+        for (size_t i = 0; i < population.parents.size(); i++) {
+            population.parents[i] = matcher.buildBoard(&gen);
+        }
+    }
+
+    // Steady state breeds into per-thread scratch boards, only the generational loop needs a second buffer.
+    if (steadyState) {
+        population.children.clear();
+        population.children.shrink_to_fit();
+    } else if (population.children.size() != population.parents.size()) {
+        population.children.assign(population.parents.size(), startingBoard);
+    }
+
+    if (!resumePath.empty())
+        resume();
+
+    // Each seed takes a different slot, worst first, so seeds never replace each other.
+    size_t seeded = std::min(seeds.size(), population.parents.size());
+    std::vector<size_t> order(population.parents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + seeded, order.end(), [&](size_t a, size_t b) {
+        return population.parents[a].getViolations() > population.parents[b].getViolations();
+    });
+    for (size_t i = 0; i < seeded; i++)
+        population.parents[order[i]].cloneFrom(seeds[i]);
 
 }
 
@@ -235,107 +508,233 @@ Running and Output
 // Solve function should be the only one you run
 size_t TTSolver::solve(){
 
+    if (islands > 0) {
+        // Every island generation breeds islandSize children, together about generationSize.
+        size_t maxGenerations = std::numeric_limits<size_t>::max();
+        if (evaluationLimit > 0)
+            maxGenerations = (evaluationLimit + generationSize - 1) / generationSize;
+        Board best = runIslands(maxGenerations);
+        if (progress != nullptr)
+            std::cout << "islands: " << islands << ", generations: " << bredGenerations << ", violations: " << best.getViolations() << std::endl;
+        if (drawBest)
+            best.drawBoard();
+        writeSolutionAsync(filePath, best);
+        if (snapshotInterval > 0.0)
+            writeSnapshot(0);
+        return best.getViolations();
+    }
+
     numTiles = numRows * numCols;
     initialize();
     size_t minViolations = startingBoard.getViolations();
-    size_t counter = 0;
-    // Loop for a given number of runs
-    int j = 1;
-    for(size_t i = 0; i < 1000000; i++){
-        iterate();
+    for (const Board &board : population.parents)
+        minViolations = std::min(minViolations, board.getViolations());
+    size_t counter = resumedStale;
+    auto start = std::chrono::steady_clock::now();
+    auto lastSnapshot = start;
+    size_t evaluations = 0;
+    for (size_t i = 0; ; i++) {
+        evaluations += steadyState ? steadyIterate() : iterate();
         //mutationChance *= coolingRate;
 
-        currentGeneration[0].drawBoard();
-
-        std::cout << "iteration: " << j++ << std::endl;
-
-        if(currentGeneration[0].getViolations() < minViolations){
-            minViolations = currentGeneration[0].getViolations(); 
+        const Board& best = population.parents[bestIndex(population.parents)];
+        if(best.getViolations() < minViolations){
+            minViolations = best.getViolations(); 
             counter = 0;
         }
-        std::cout << minViolations << std::endl;
-        if(minViolations == 0 || counter >= maxGenerationsNoImprovement){
-            // std::cout << "enter c to continue or p for continue and make output" << std::endl;
-            // std::string a;
-            // std::cin >> a;
-            // if(a == "c"){
-            //     counter = 0;
-            // }
-            // else if (a == "p"){
-            //     counter = 0;
-            //     createOutput();
-            //     return minViolations;
-            // }
-            // else{
-            //     createOutput();
-            //     return minViolations;
-            // }
-            createOutput();
-            return minViolations;
+        // Diversity is from the parents this generation was bred from, it is not worth another pass.
+        if (progress != nullptr)
+            progress->publish(i + 1, minViolations, evaluations, population.diversity.mean());
+
+        if(minViolations == 0 || counter >= maxGenerationsNoImprovement || stopRequested())
+            break;
+        if (evaluationLimit > 0 && evaluations >= evaluationLimit)
+            break;
+        if (timeLimitSeconds > 0.0 && evaluationLimit == 0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= timeLimitSeconds)
+            break;
+        counter++;
 
+        if (snapshotInterval > 0.0
+            && std::chrono::duration<double>(std::chrono::steady_clock::now() - lastSnapshot).count() >= snapshotInterval) {
+            writeSnapshot(counter);
+            lastSnapshot = std::chrono::steady_clock::now();
         }
-        counter++;
     }
+
+    if (snapshotInterval > 0.0)
+        writeSnapshot(counter);
+    if (drawBest)
+        population.parents[bestIndex(population.parents)].drawBoard();
+    createOutput();
+    return minViolations;
 }
 
-bool TTSolver::createOutput() {
+size_t TTSolver::runGenerations(size_t count){
 
-    std::filesystem::path inputPath(filePath);
-    std::string baseName = inputPath.stem().string();
-    std::filesystem::path directory = inputPath.parent_path();
+    initialize();
+    return step(count);
+}
 
-    // get output folder name
-    std::string outputFolderName = baseName + "_output";
-    std::filesystem::path outputFolderPath = directory / outputFolderName;
+size_t TTSolver::step(size_t count){
 
-    // Make new output folder
-    if (!std::filesystem::exists(outputFolderPath)) {
-        if (!std::filesystem::create_directory(outputFolderPath)) {
-            std::cerr << "Error creating output directory: " << outputFolderPath << std::endl;
-            return false;
-        }
+    for (size_t i = 0; i < count; i++) {
+        if (steadyState)
+            steadyIterate();
+        else
+            iterate();
     }
 
-    // random number for name
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dis(1, 999999);
-    int randomIndex = dis(gen);
-
-    // Construct the output file name with the random index.
-    std::filesystem::path outFilePath = outputFolderPath / (baseName + '_' + std::to_string(randomIndex) + ".out");
-    std::ofstream outFile(outFilePath);
-    if (!outFile) {
-        std::cerr << "Error opening file for writing: " << outFilePath << std::endl;
-        return false;
+    size_t minViolations = startingBoard.getViolations();
+    for (const Board &board : population.parents)
+        minViolations = std::min(minViolations, board.getViolations());
+    return minViolations;
+}
+
+Board TTSolver::runIslands(size_t maxGenerations){
+
+    initialize();
+    auto deadline = std::chrono::steady_clock::time_point::max();
+    if (timeLimitSeconds > 0.0 && evaluationLimit == 0)
+        deadline = std::chrono::steady_clock::now()
+            + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(timeLimitSeconds));
+
+    // Every island needs at least one elite and one pair of children, populations under 4 make a single smaller island.
+    size_t count = std::max<size_t>(std::min(islands, generationSize / 4), 1);
+    size_t islandSize = generationSize / count;
+    size_t islandElites = std::clamp<size_t>(elitismNum * islandSize / generationSize, 1, std::max<size_t>(islandSize, 3) - 2);
+
+    std::vector<Population> pops(count);
+    for (size_t k = 0; k < count; k++) {
+        auto first = population.parents.begin() + k * islandSize;
+        pops[k].parents.assign(std::make_move_iterator(first), std::make_move_iterator(first + islandSize));
+        pops[k].children = pops[k].parents;
+        pops[k].elites = islandElites;
     }
 
-    // Sort the current generation
-    std::sort(currentGeneration.begin(), currentGeneration.end(),
-        [](const Board &a, const Board &b) {
-            return a.getViolations() < b.getViolations();
+    // One channel per ordered pair of islands, so every queue has a single producer and a single consumer.
+    std::vector<SpscQueue<Board, 4>> channels(count * count);
+    std::atomic<bool> solved{false};
+    std::atomic<size_t> generations{0};
+    std::atomic<size_t> bestSeen{std::numeric_limits<size_t>::max()};
+    unsigned baseSeed = nextSeed();
+
+    #pragma omp parallel num_threads(count)
+    {
+        size_t k = omp_get_thread_num();
+        Population& island = pops[k];
+        std::mt19937 gen(baseSeed + k);
+        std::uniform_int_distribution<size_t> otherIsland(1, std::max<size_t>(count - 1, 1));
+
+        size_t minViolations = island.parents[bestIndex(island.parents)].getViolations();
+        size_t stale = 0;
+        size_t g = 0;
+        for (; g < maxGenerations && stale < maxGenerationsNoImprovement && !solved.load(std::memory_order_relaxed) && !stopRequested()
+             && std::chrono::steady_clock::now() < deadline; g++) {
+            prepare(island);
+            for (size_t i = island.elites; i < islandSize; i += 2) {
+                Board *secondChild = i + 1 < islandSize ? &island.children[i + 1] : nullptr;
+                std::pair<size_t, size_t> parents = breed(island, island.children[i], secondChild, gen);
+                if (crowding)
+                    crowdingReplace(island, parents, island.children[i], secondChild);
+            }
+            std::swap(island.children, island.parents);
+
+            if (count > 1 && (g + 1) % migrationInterval == 0) {
+                // Arrivals replace the worst boards, then the best board leaves for a neighbour.
+                for (size_t from = 0; from < count; from++) {
+                    if (from == k)
+                        continue;
+                    while (channels[from * count + k].tryPop(island.parents[worstIndex(island.parents)])) {}
+                }
+                size_t to = topology == Topology::RING ? (k + 1) % count : (k + otherIsland(gen)) % count;
+                channels[k * count + to].tryPush(island.parents[bestIndex(island.parents)]);
+            }
+
+            size_t violations = island.parents[bestIndex(island.parents)].getViolations();
+            if (violations < minViolations) {
+                minViolations = violations;
+                stale = 0;
+            } else {
+                stale++;
+            }
+            if (minViolations == 0)
+                solved.store(true, std::memory_order_relaxed);
+
+            size_t total = generations.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (progress != nullptr) {
+                size_t seen = bestSeen.load(std::memory_order_relaxed);
+                while (minViolations < seen && !bestSeen.compare_exchange_weak(seen, minViolations, std::memory_order_relaxed)) {}
+                progress->publish(total / count, std::min(seen, minViolations), total * islandSize, island.diversity.mean());
+            }
         }
-    );
-    const Board &bestBoard = currentGeneration[0];
+    }
 
-    // Write the total number of violations
-    outFile << bestBoard.getViolations() << "\n";
+    bredGenerations = generations;
 
-    TilesSet bestTentTiles = bestBoard.getTentTilesData();
+    // Hand the islands back so the population stays whole.
+    for (size_t k = 0; k < count; k++)
+        std::move(pops[k].parents.begin(), pops[k].parents.end(), population.parents.begin() + k * islandSize);
+    return population.parents[bestIndex(population.parents)];
+}
 
-    // Second line number of tents added
-    outFile << bestTentTiles.size() << "\n";
+bool TTSolver::resume() {
+    std::ifstream file(resumePath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Nothing to resume from at " << resumePath << std::endl;
+        return false;
+    }
+    std::ostringstream contents;
+    contents << file.rdbuf();
+    std::string data = std::move(contents).str();
+
+    if (Snapshot::looksLikeSnapshot(data)) {
+        std::optional<Snapshot> snapshot = Snapshot::decode(data, startingBoard);
+        if (!snapshot || snapshot->boards.empty()) {
+            std::cerr << "Ignoring damaged snapshot " << resumePath << std::endl;
+            return false;
+        }
+        // The population size may have changed since, boards are reused round robin.
+        for (size_t i = 0; i < population.parents.size(); i++)
+            population.parents[i].cloneFrom(snapshot->boards[i % snapshot->boards.size()]);
+        population.generation = snapshot->generation;
+        // Without it a seeded run would draw again from where setSeed left off, not where the snapshot stopped.
+        if (!snapshot->randomState.empty()) {
+            std::istringstream state(snapshot->randomState);
+            state >> seeder;
+        }
+        // A run that ran out of patience resumes with fresh patience, otherwise it would stop straight away.
+        resumedStale = snapshot->stale < maxGenerationsNoImprovement ? snapshot->stale : 0;
+        return true;
+    }
 
-    // tentCount lines of row col dir
-    for (int i = 0; i < bestTentTiles.size(); i++) {
+    Board solution = startingBoard;
+    Verifier::Result result = Verifier(startingBoard).verifyText(data, solution);
+    if (!result.valid) {
+        std::cerr << "Ignoring " << resumePath << ": " << result.error << std::endl;
+        return false;
+    }
+    // A single solution takes the worst seeded slot, the rest of the population keeps its diversity.
+    population.parents[worstIndex(population.parents)].cloneFrom(solution);
+    return true;
+}
 
-        int row = bestTentTiles.getTileAtIndex(i).value().getRow();
-        int col = bestTentTiles.getTileAtIndex(i).value().getCol();
+void TTSolver::writeSnapshot(size_t stale) {
+    std::ostringstream state;
+    state << seeder;
+    std::string buffer;
+    Snapshot::encode(population.parents, population.generation, stale, state.str(), buffer);
+    writeFileAsync(snapshotPath, std::move(buffer));
+}
 
-        outFile << row + 1 << " " << col + 1 << " " << bestBoard.getBoard()[row][col].getDir() << std::endl;
+const Board& TTSolver::getBestBoard() const {
+    return population.parents[bestIndex(population.parents)];
+}
 
-    }
+bool TTSolver::createOutput() {
 
-    outFile.close();
+    // The parents hold the last generation, elites included
+    // Formatted right here, the file itself is written on the background writer
+    writeSolutionAsync(filePath, population.parents[bestIndex(population.parents)]);
     return true;
 }
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "board.h"
+#include "diversityMatrix.h"
+#include "progressReporter.h"
+
+#include <filesystem>
+#include <string>
 
 #include <stdlib.h>
+#include <algorithm>
 #include <vector>
 #include <random>
 
@@ -32,8 +38,155 @@ class TTSolver {
     coolingRate = static_cast<double>(mutationChance) / static_cast<double>(maxGenerationsNoImprovement);
     }
 
+    /**
+     * @brief Which part of the second parent a child inherits, every operator copies the region word by word
+     */
+    enum class Crossover {
+        ONE_POINT,   // Every cell from a random index to the end
+        TWO_POINT,   // Cells between two random indices
+        UNIFORM,     // Every cell independently with probability 1/2
+        ROW_BLOCK,   // A random band of whole rows
+        RECTANGLE    // A random 2D window
+    };
+
+    void setCrossover(Crossover kind) { crossoverKind = kind; }
+
+    /**
+     * @brief Fitness sharing, tournaments compare violations * niche count within radius cells; 0 turns it off
+     */
+    void setSharingRadius(double radius) { sharingRadius = radius; }
+
+    /**
+     * @brief Deterministic crowding, each child only survives if it is no worse than the parent closest to it
+     */
+    void setCrowding(bool enabled) { crowding = enabled; }
+
+    /**
+     * @brief Violation-guided mutation, half of all mutations repair a member of the board's conflict sets
+     * (off-quota row/col, touching tent, lonely tent or lonely tree) instead of touching a uniformly random cell
+     */
+    void setTargetedMutation(bool enabled) { targetedMutation = enabled; }
+
+    /**
+     * @brief Every interval generations each parent's tents are re-paired with their trees (Board::optimisePairing)
+     * before selection; 0 turns it off
+     */
+    void setPairingInterval(size_t interval) { pairingInterval = interval; }
+
+    /**
+     * @brief Steady-state mode, one population updated in place instead of two swapped generations
+     * Children are bred into per-thread scratch boards and replace the worst board (the closest parent with
+     * crowding) only if they have fewer violations, so no elite sort or copy is needed.
+     */
+    void setSteadyState(bool enabled) { steadyState = enabled; }
+
+    /**
+     * @brief Boards held by the population, second buffer and scratch boards included
+     */
+    size_t residentBoards() const { return population.parents.size() + population.children.size() + scratch.size(); }
+
+    /**
+     * @brief Where an island sends its elite every migration
+     */
+    enum class Topology {
+        RING,   // Always the next island
+        RANDOM  // Any other island, drawn every migration
+    };
+
+    /**
+     * @brief Island mode, the population is split into count islands that each breed on their own thread; 0 turns it off
+     * Islands never wait on each other, every migrationInterval generations an island sends a copy of its best board
+     * and takes in whatever has arrived in place of its worst boards.
+     */
+    void setIslands(size_t count, Topology kind = Topology::RING, size_t interval = 5) {
+        islands = count;
+        topology = kind;
+        migrationInterval = std::max<size_t>(interval, 1);
+    }
+
+    /**
+     * @brief Where solve() publishes generation, best violations, boards bred and diversity; null keeps it quiet
+     * The reporter must outlive the solve() call.
+     */
+    void setProgress(ProgressReporter* reporter) { progress = reporter; }
+
+    /**
+     * @brief Renders the best board once when solve() finishes, the loop itself never draws
+     */
+    void setDrawBest(bool enabled) { drawBest = enabled; }
+
+    /**
+     * @brief Checkpoints the whole population to path every intervalSeconds and when solve() ends (see Snapshot)
+     * Encoding runs between generations, the write itself is atomic and happens on the background writer.
+     * Island mode only writes the final snapshot. An interval of 0 turns snapshots off.
+     */
+    void setSnapshots(std::filesystem::path path, double intervalSeconds) {
+        snapshotPath = std::move(path);
+        snapshotInterval = intervalSeconds;
+    }
+
+    /**
+     * @brief Seeds the next run from a snapshot (population, generation and stale counters) or from a .out file,
+     * which replaces the worst seeded board; a missing or damaged file only prints a warning
+     */
+    void setResume(std::string path) { resumePath = std::move(path); }
+
+    /**
+     * @brief Boards that take the places of the worst seeded boards when the population is built, e.g. from WarmStart
+     */
+    void setSeeds(std::vector<Board> boards) { seeds = std::move(boards); }
+
+    /**
+     * @brief Wall-clock limit for solve(), checked between generations; 0 leaves only the stale generation limit
+     * Ignored while an evaluation limit is set, so that limit alone decides where a seeded run stops.
+     */
+    void setTimeLimit(double seconds) { timeLimitSeconds = seconds; }
+
+    /**
+     * @brief Stops solve() once at least this many children have been bred, 0 for no limit
+     * Counts the children actually bred: generationSize minus the elites a generation, or every steady-state birth.
+     * Unlike setTimeLimit the stopping point does not depend on the machine, see setSeed.
+     */
+    void setEvaluationLimit(size_t evaluations) { evaluationLimit = evaluations; }
+
+    /**
+     * @brief Seeds every random choice the solver makes, otherwise it draws a seed from std::random_device
+     * With the same seed, thread count and an evaluation limit instead of a time limit, two runs breed the same
+     * boards. Island migration depends on thread timing and stays nondeterministic.
+     */
+    void setSeed(uint64_t seed) { seeder.seed(seed); }
+
+    /**
+     * @brief Best board of the current population, the one solve() wrote
+     */
+    const Board& getBestBoard() const;
+
     size_t solve();
 
+    /**
+     * @brief Runs a fixed number of generations with no output, used for benchmarking
+     * @return best number of violations in the last generation
+     */
+    size_t runGenerations(size_t count);
+
+    /**
+     * @brief Runs count more generations on the current population without reseeding it
+     * @return best number of violations in the population
+     */
+    size_t step(size_t count);
+
+    /**
+     * @brief Runs the island model until every island has bred maxGenerations generations, gone
+     * maxGenerationsNoImprovement generations without improving, or any island reaches zero violations
+     * @return best board over all islands
+     */
+    Board runIslands(size_t maxGenerations);
+
+    /**
+     * @brief Generations bred by the last runIslands call, summed over islands
+     */
+    size_t islandGenerations() const { return bredGenerations; }
+
     private:
 
     // Tune-ables (tuna?)
@@ -47,6 +200,31 @@ class TTSolver {
 
     int selectionFactor;
 
+    Crossover crossoverKind = Crossover::ONE_POINT;
+    double sharingRadius = 0.0;
+    bool crowding = false;
+    bool targetedMutation = true;
+    size_t pairingInterval = 10;
+
+    ProgressReporter* progress = nullptr;
+    bool drawBest = false;
+
+    std::filesystem::path snapshotPath;
+    double snapshotInterval = 0.0;
+    std::string resumePath;
+    size_t resumedStale = 0;
+    std::vector<Board> seeds;
+    double timeLimitSeconds = 0.0;
+    size_t evaluationLimit = 0;
+
+    // Hands out the base seed of every generation, thread t of a generation breeds with base seed + t
+    std::mt19937_64 seeder{std::random_device{}()};
+
+    bool steadyState = false;
+    size_t islands = 0;
+    Topology topology = Topology::RING;
+    size_t migrationInterval = 5;
+
     char * filePath;
 
     size_t numTiles;
@@ -55,11 +233,34 @@ class TTSolver {
 
     size_t initalEmptyTiles;
 
-    Board bestBoard = std::move(startingBoard);
-    
-    // Holds the set of boards, starting with a set starting board
-    std::vector<Board> currentGeneration{generationSize, startingBoard};
-    std::vector<Board> parentGeneration{generationSize, startingBoard};
+    Board bestBoard = startingBoard;
+
+    /**
+     * @brief One breeding population, the whole generation normally or a single island
+     */
+    struct Population {
+        Population() = default;
+        Population(size_t size, const Board& board, size_t elites) : parents(size, board), elites(elites) {}
+
+        std::vector<Board> parents;
+        std::vector<Board> children;
+        size_t elites = 0;
+        size_t generation = 0;
+
+        // Rebuilt from parents at the start of every generation
+        DiversityMatrix diversity;
+        std::vector<double> nicheCounts;
+        std::vector<double> sharedViolations;
+    };
+
+    // Holds the set of boards, starting with a set starting board; the children are made in initialize()
+    Population population{generationSize, startingBoard, static_cast<size_t>(elitismNum)};
+
+    // Two children per thread for steady-state breeding, and the parents each pair came from
+    std::vector<Board> scratch;
+    std::vector<std::pair<size_t, size_t>> scratchParents;
+
+    size_t bredGenerations = 0;
 
     /**
      * @brief Creates the output file with the current iteration of the chart.
@@ -76,28 +277,83 @@ class TTSolver {
 
     /**
      * @brief Main iteration loop
+     * @return children bred, generationSize minus the elites carried over
+     */
+    size_t iterate();
+
+    /**
+     * @brief One generation's worth of steady-state births
+     * @return children bred, two per thread and round, so it depends on the thread count
+     */
+    size_t steadyIterate();
+
+    /**
+     * @brief Sorts the elites to the front, rebuilds the distance caches and copies the elites into the children
+     */
+    void prepare(Population&);
+
+    /**
+     * @brief Rebuilds the distance matrix, niche counts and shared violations from the parents
      */
-    void iterate();
+    void refreshCaches(Population&);
+
+    /**
+     * @brief Runs Board::optimisePairing over the parents when the population is due, see setPairingInterval
+     */
+    void repairPairings(Population&);
+
+    /**
+     * @brief Selects two parents and breeds them into child1 and child2 (may be null)
+     * @return the parents' indices
+     */
+    std::pair<size_t, size_t> breed(const Population&, Board &child1, Board *child2, std::mt19937 &gen);
 
     /**
      * @brief Selects the next generation
      */
-    std::pair<size_t, size_t> selection(std::mt19937 &gen);
+    std::pair<size_t, size_t> selection(const Population&, std::mt19937 &gen);
 
     /**
      * @brief Creates the next generation and mixes genes
+     * Children are cloned into the given boards so their buffers are reused; child2 may be null for an odd slot
+     */
+    void crossover(const Population&, std::pair<size_t, size_t>&, Board &child1, Board *child2, std::mt19937 &gen);
+
+    /**
+     * @brief Mutates a single child of the next generation
      */
-    std::pair<Board, Board> crossover(std::pair<size_t, size_t>&, std::mt19937 &gen);
+    void mutation(Board&, std::mt19937 &gen);
 
     /**
-     * @brief Mutates the next generation
+     * @brief Proposes one repair for a random conflict on the board and commits it if it adds no violations
+     * @return false if no repair could be proposed, the board has no conflicts left or the drawn one has no fix
      */
-    void mutation(std::pair<Board, Board>&, std::mt19937 &gen);
+    bool repairMutation(Board&, std::mt19937 &gen);
+
+    /**
+     * @brief Deterministic crowding replacement, pairs each child with its closer parent and keeps the better one
+     */
+    void crowdingReplace(const Population&, const std::pair<size_t, size_t>& parents, Board &child1, Board *child2);
 
     void initialize();
 
+    /**
+     * @brief Base seed for the next generation's per-thread generators
+     */
+    unsigned nextSeed() { return static_cast<unsigned>(seeder()); }
+
+    /**
+     * @brief Loads resumePath into the seeded population, see setResume
+     */
+    bool resume();
+
+    /**
+     * @brief Queues a snapshot of the parents for the background writer
+     */
+    void writeSnapshot(size_t stale);
+
     std::vector<int> splice(const std::vector<int>& array, int startIndex, int endIndex);
 
-    double weightedPairScore(const Board &a, const Board &b);
+    double weightedPairScore(const Population&, size_t a, size_t b) const;
 
 };
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "verifier.h"
+#include "mappedFile.h"
+
+#include <charconv>
+#include <vector>
+
+Verifier::Verifier(const Board& inputBoard) : inputBoard(inputBoard) {}
+
+/*
+////////////////////////////////////////////////////
+Tokenizing, mirrors Python's str.strip/split/int
+////////////////////////////////////////////////////
+*/
+
+static bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front()))
+        text.remove_prefix(1);
+    while (!text.empty() && isSpace(text.back()))
+        text.remove_suffix(1);
+    return text;
+}
+
+// Whole-token integer with an optional sign, like int()
+static bool parseInteger(std::string_view token, long long& value) {
+    if (!token.empty() && token.front() == '+')
+        token.remove_prefix(1);
+    if (token.empty())
+        return false;
+    auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    return ec == std::errc() && ptr == token.data() + token.size();
+}
+
+// Splits line on whitespace into at most maxTokens tokens, returns how many tokens the line really has
+static size_t splitTokens(std::string_view line, std::string_view* tokens, size_t maxTokens) {
+    size_t count = 0;
+    size_t i = 0;
+    while (i < line.size()) {
+        while (i < line.size() && isSpace(line[i]))
+            i++;
+        if (i == line.size())
+            break;
+        size_t start = i;
+        while (i < line.size() && !isSpace(line[i]))
+            i++;
+        if (count < maxTokens)
+            tokens[count] = line.substr(start, i - start);
+        count++;
+    }
+    return count;
+}
+
+/*
+////////////////////////////////////////////////////
+Verification
+////////////////////////////////////////////////////
+*/
+
+Verifier::Result Verifier::verifyText(std::string_view text, Board& scratch) const {
+    Result result;
+    auto fail = [&result](std::string error) {
+        result.error = std::move(error);
+        return result;
+    };
+
+    // Same as f.read().strip().splitlines()
+    text = trim(text);
+    std::vector<std::string_view> lines;
+    while (!text.empty()) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        lines.push_back(line);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+
+    if (lines.size() < 2)
+        return fail("Output file format error: Not enough lines.");
+
+    if (!parseInteger(trim(lines[0]), result.claimedViolations) || !parseInteger(trim(lines[1]), result.claimedTents))
+        return fail("Output file format error: First two lines must be integers.");
+
+    scratch.cloneFrom(inputBoard);
+    long long rows = static_cast<long long>(scratch.getNumRows());
+    long long cols = static_cast<long long>(scratch.getNumCols());
+
+    for (size_t i = 2; i < lines.size(); i++) {
+        std::string_view tokens[3];
+        if (splitTokens(lines[i], tokens, 3) != 3)
+            return fail("Output file format error: Each operation line must have 3 values (row, col, symbol).");
+
+        long long row, col;
+        if (!parseInteger(tokens[0], row) || !parseInteger(tokens[1], col))
+            return fail("Output file format error: Row and column values must be integers.");
+
+        // Appended piece by piece, GCC 12 flags a bogus -Wrestrict on "(" + std::to_string(...)
+        auto at = [row, col]() {
+            std::string text = "(";
+            text += std::to_string(row);
+            text += ", ";
+            text += std::to_string(col);
+            text += ")";
+            return text;
+        };
+        if (row < 1 || row > rows || col < 1 || col > cols)
+            return fail("Operation " + at() + " is out of grid bounds.");
+
+        std::string_view symbol = tokens[2];
+        if (symbol != "U" && symbol != "D" && symbol != "L" && symbol != "R" && symbol != "X")
+            return fail("Output file format error: Symbol must be one of U, D, L, R, or X.");
+        char dir = symbol.front();
+
+        size_t r = row - 1;
+        size_t c = col - 1;
+        if (scratch.getType(r, c) == Type::TREE)
+            return fail("Cannot place tent on a tree, invalid operation");
+
+        if (dir != 'X') {
+            long long treeRow = r + (dir == 'U' ? -1 : (dir == 'D' ? 1 : 0));
+            long long treeCol = c + (dir == 'L' ? -1 : (dir == 'R' ? 1 : 0));
+            if (treeRow < 0 || treeRow >= rows || treeCol < 0 || treeCol >= cols)
+                return fail("Operation " + at() + " with symbol " + dir + " is invalid: tree position out of bounds.");
+            if (scratch.getType(treeRow, treeCol) != Type::TREE)
+                return fail("Operation " + at() + " with symbol " + dir + " is invalid: no tree found in the expected direction.");
+        }
+
+        // autograder.py lets a cell be listed twice and then counts it inconsistently, a Board cannot hold that.
+        if (scratch.getType(r, c) == Type::TENT)
+            return fail("Operation " + at() + " places a second tent on the same cell.");
+
+        scratch.placeTent(Coord(r, c), dir);
+        result.tents++;
+    }
+
+    result.valid = true;
+    result.violations = scratch.getViolations();
+    return result;
+}
+
+Verifier::Result Verifier::verify(const std::string& outputPath, Board& scratch) const {
+    MappedFile file(outputPath);
+    if (!file.isOpen()) {
+        Result result;
+        result.error = "Error reading output file " + outputPath;
+        return result;
+    }
+    return verifyText(file.view(), scratch);
+}
+
+Verifier::Result Verifier::verify(const std::string& outputPath) const {
+    Board scratch(inputBoard);
+    return verify(outputPath, scratch);
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "board.h"
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Native replacement for autograder.py's grade command
+ * Replays an output file's tents onto a copy of the input board, so the violation count comes straight from
+ * Board's incremental counters in O(tents) instead of rescanning the grid per row and column.
+ * Every check parseOutputFile performs is applied with the same error messages.
+ */
+class Verifier {
+    public:
+    /**
+     * @brief Outcome of verifying one output file
+     */
+    struct Result {
+        bool valid = false;           // False when the file breaks a format or placement rule, see error
+        std::string error;
+        long long claimedViolations = 0;
+        long long claimedTents = 0;
+        size_t tents = 0;             // Tent lines actually listed
+        size_t violations = 0;        // Violations of the board the tents describe
+
+        bool matches() const { return valid && claimedViolations == static_cast<long long>(violations); }
+    };
+
+    /**
+     * @brief Keeps a reference to the parsed input, it must outlive the verifier
+     */
+    explicit Verifier(const Board& inputBoard);
+
+    /**
+     * @brief Verifies one output file
+     * @param scratch board the tents are replayed on, reset from the input first so one board per thread can be reused
+     */
+    Result verify(const std::string& outputPath, Board& scratch) const;
+    Result verify(const std::string& outputPath) const;
+
+    /**
+     * @brief Verifies output text already in memory, same rules as verify
+     */
+    Result verifyText(std::string_view text, Board& scratch) const;
+
+    private:
+    const Board& inputBoard;
+};
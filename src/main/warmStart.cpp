@@ -0,0 +1,53 @@
+#include "warmStart.h"
+#include "output.h"
+#include "verifier.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <omp.h>
+
+WarmStart WarmStart::load(const char* inputFilePath, const Board& startingBoard, size_t count) {
+    WarmStart warm;
+    std::vector<std::string> outputs;
+    std::error_code error;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(outputDirectory(inputFilePath), error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".out")
+            outputs.push_back(entry.path().string());
+    }
+    warm.scanned = outputs.size();
+    if (outputs.empty() || count == 0)
+        return warm;
+
+    // Only the scores are kept on the first pass, the winners are replayed again below.
+    Verifier verifier(startingBoard);
+    std::vector<Verifier::Result> results(outputs.size());
+    #pragma omp parallel
+    {
+        std::unique_ptr<Board> scratch;
+        #pragma omp for schedule(dynamic, 1)
+        for (size_t i = 0; i < outputs.size(); i++) {
+            if (!scratch)
+                scratch = std::make_unique<Board>(startingBoard);
+            results[i] = verifier.verify(outputs[i], *scratch);
+        }
+    }
+
+    std::vector<size_t> ranked;
+    for (size_t i = 0; i < outputs.size(); i++) {
+        if (results[i].valid)
+            ranked.push_back(i);
+    }
+    warm.rejected = outputs.size() - ranked.size();
+    count = std::min(count, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(), [&](size_t a, size_t b) {
+        return results[a].violations < results[b].violations;
+    });
+
+    warm.boards.assign(count, startingBoard);
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < count; i++)
+        verifier.verify(outputs[ranked[i]], warm.boards[i]);
+    return warm;
+}
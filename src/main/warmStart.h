@@ -0,0 +1,22 @@
+#pragma once
+
+#include "board.h"
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Earlier solutions of one input, read back from its output directory
+ * Every .out file is verified against the input in parallel, invalid ones are skipped,
+ * and only the best few are rebuilt as boards.
+ */
+struct WarmStart {
+    std::vector<Board> boards;   // Best first, at most the count asked for
+    size_t scanned = 0;          // .out files found
+    size_t rejected = 0;         // Files that failed verification
+
+    /**
+     * @brief Loads the count best solutions of inputFilePath, ranked by the violations their tents really produce
+     */
+    static WarmStart load(const char* inputFilePath, const Board& startingBoard, size_t count);
+};
@@ -2,6 +2,64 @@
 #include "../main/board.h"
 #include "../main/tile.h"
 #include "../main/input.h"
+#include "../main/annealer.h"
+#include "../main/parallelTempering.h"
+#include "../main/tentMatcher.h"
+#include "../main/exactSolver.h"
+#include "../main/clusterSolver.h"
+#include "../main/verifier.h"
+#include "../main/diversityMatrix.h"
+#include "../main/spscQueue.h"
+#include "../main/ttsolver.h"
+#include "../main/tilesSet.h"
+#include "../main/progressReporter.h"
+#include "../main/output.h"
+#include "../main/snapshot.h"
+#include "../main/stopSignal.h"
+#include "../main/warmStart.h"
+#include "../main/batchScheduler.h"
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <omp.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <functional>
+#include <sstream>
+
+/*
+Allocation counting hook: every operator new in the test binary is counted while countAllocations is set
+*/
+static std::atomic<bool> countAllocations{false};
+static std::atomic<size_t> allocationCount{0};
+static std::atomic<size_t> largestAllocation{0};
+
+static void* countedAllocation(std::size_t size, std::size_t alignment) {
+  if (countAllocations.load(std::memory_order_relaxed)) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t largest = largestAllocation.load(std::memory_order_relaxed);
+    while (size > largest && !largestAllocation.compare_exchange_weak(largest, size, std::memory_order_relaxed)) {}
+  }
+  size = std::max<std::size_t>(size, 1);
+  void* p = alignment > alignof(std::max_align_t) ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment) : std::malloc(size);
+  if (p == nullptr)
+    throw std::bad_alloc();
+  return p;
+}
+
+void* operator new(std::size_t size) { return countedAllocation(size, 0); }
+void* operator new[](std::size_t size) { return countedAllocation(size, 0); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocation(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocation(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
 
 /**
  * @brief Testing if board construction properly works
@@ -149,6 +207,62 @@ TEST(BoardEquivalence, IOTest){
   EXPECT_EQ(output, expected);
 }
 
+/**
+ * @brief Every malformed file is rejected with the same message the line-based parser used
+ * @test Input::inputFromFile()
+ */
+TEST(InvalidInput, IOTest){
+  std::string filePath = std::filesystem::temp_directory_path() / "tt_invalid_input.test";
+  std::vector<std::pair<std::string, std::string>> cases = {
+    {"", "Invalid input: R and C must be positive integers"},
+    {"3 x\n", "Invalid input: R and C must be positive integers"},
+    {"3 4 5\n", "Invalid input: extra characters detected after R and C"},
+    {"0 4\n", "Invalid input: R and C must be greater than zero"},
+    {"400 400\n", "Invalid input: R * C exceeds 10^5"},
+    {"2 2\n1\n1 1\n..\n..\n", "Invalid input: r_i value must be a non-negative integer"},
+    {"2 2\n3 1\n1 1\n..\n..\n", "Invalid input: r_i is greater than C"},
+    {"2 2\n1 1\n1 a\n..\n..\n", "Invalid input: c_i value must be a non-negative integer"},
+    {"2 2\n1 1\n1 3\n..\n..\n", "Invalid input: c_i is greater than R"},
+    {"2 2\n1 1\n1 1\n.X\n..\n", "Invalid input: Tile is not '.' or 'T'"},
+    {"2 2\n1 1\n1 1\n..\n.\n", "Invalid input: Tile is not '.' or 'T'"},
+    {"2 2\n1 1\n1 1\n..\n", "Invalid input: Tile is not '.' or 'T'"},
+  };
+
+  Input input;
+  for (const auto& [contents, message] : cases) {
+    std::ofstream(filePath, std::ios::trunc) << contents;
+    try {
+      input.inputFromFile(filePath);
+      ADD_FAILURE() << "accepted: " << contents;
+    } catch (const std::runtime_error& error) {
+      EXPECT_EQ(std::string(error.what()), message) << contents;
+    }
+  }
+  EXPECT_THROW(input.inputFromFile(filePath + ".missing"), std::runtime_error);
+
+  // Trailing spaces and CRLF line endings still parse.
+  std::ofstream(filePath, std::ios::trunc) << "2 2 \r\n1 1\r\n 1 1\r\nT.\r\n.T\r\n";
+  Board board = input.inputFromFile(filePath);
+  EXPECT_EQ(board.getNumTrees(), 2);
+  EXPECT_EQ(board.getType(1, 1), Type::TREE);
+  std::filesystem::remove(filePath);
+}
+
+/**
+ * @brief A board rebuilt from its own flat cells matches the original, tents included
+ * @test Board(rows, cols, rowTentNum, colTentNum, packedCells)
+ */
+TEST(FlatConstruction, BoardUnitTests){
+  Input input;
+  Board board = TentMatcher(input.inputFromFile("../tests/test6.test")).buildBoard();
+  Board rebuilt(board.getNumRows(), board.getNumCols(), board.getRowTentNum(), board.getColTentNum(), board.getCells());
+  EXPECT_EQ(rebuilt.getCells(), board.getCells());
+  EXPECT_EQ(rebuilt.getViolations(), board.getViolations());
+  EXPECT_EQ(rebuilt.getNumTrees(), board.getNumTrees());
+  EXPECT_EQ(rebuilt.getTentTilesData().size(), board.getTentTilesData().size());
+  EXPECT_EQ(rebuilt.getOpenTilesData().size(), board.getOpenTilesData().size());
+}
+
 TEST(BoardEquivalence, CompareBoardObjects) {
   std::string filePath = "../tests/one.test";
   Input input;
@@ -234,7 +348,8 @@ TEST(RemoveTent, TentMoves){
   Board generatedBoard = input.inputFromFile(filePath);
 
   std::mt19937 localGen(std::random_device{}());
-  generatedBoard.setTile(Tile(Type::TENT, 0, 0), std::mt19937(std::random_device{}()));
+  std::mt19937 tileGen(std::random_device{}());
+  generatedBoard.setTile(Tile(Type::TENT, 0, 0), tileGen);
 
   generatedBoard.removeTent(localGen);
 
@@ -243,3 +358,1120 @@ TEST(RemoveTent, TentMoves){
   EXPECT_EQ(generatedBoard.removeTent(localGen), false);
 
 }
+
+/**
+ * @brief Random tent moves must leave the incremental counters equal to a fresh rebuild
+ * @test placeTent()
+ * @test deleteTent()
+ * @test getViolations()
+ */
+TEST(IncrementalViolations, TentMoves){
+  std::string filePath = "../tests/test5.test";
+  Input input;
+  Board board = input.inputFromFile(filePath);
+  std::mt19937 localGen(7);
+
+  for (int i = 0; i < 2000; i++) {
+    if (i % 3 == 0)
+      board.removeTent(localGen);
+    else
+      board.addTent(localGen);
+
+    if (i % 100 == 0) {
+      Board rebuilt(board.getNumRows(), board.getNumCols(), board.getRowTentNum(), board.getColTentNum(), board.getBoard(), board.getNumTrees());
+      EXPECT_EQ(rebuilt.getViolations(), board.getViolations()) << "after move " << i;
+      EXPECT_EQ(rebuilt.getTentViolations(), board.getTentViolations()) << "after move " << i;
+      EXPECT_EQ(rebuilt.getTreeViolations(), board.getTreeViolations()) << "after move " << i;
+    }
+  }
+}
+
+/**
+ * @brief Cloned and moved boards must carry the exact same state as the source
+ * @test cloneFrom()
+ * @test Board(Board&&)
+ */
+TEST(CloneAndMove, BoardUnitTests){
+  Input input;
+  Board source = input.inputFromFile("../tests/test5.test");
+  Board target = input.inputFromFile("../tests/one.test");
+  std::mt19937 localGen(3);
+  for (int i = 0; i < 20; i++)
+    source.addTent(localGen);
+
+  target.cloneFrom(source);
+  EXPECT_EQ(target.getViolations(), source.getViolations());
+  EXPECT_EQ(target.getNumRows(), source.getNumRows());
+  EXPECT_EQ(target.getCells(), source.getCells());
+
+  Board moved(std::move(target));
+  EXPECT_EQ(moved.getViolations(), source.getViolations());
+  EXPECT_EQ(moved.getTentTilesData().size(), source.getTentTilesData().size());
+
+  // The clone must stay fully usable for further moves.
+  moved.removeTent(localGen);
+  Board rebuilt(moved.getNumRows(), moved.getNumCols(), moved.getRowTentNum(), moved.getColTentNum(), moved.getBoard(), moved.getNumTrees());
+  EXPECT_EQ(rebuilt.getViolations(), moved.getViolations());
+}
+
+/**
+ * @brief Predicted deltas must match the counters after actually applying each move
+ * @test deltaAdd()
+ * @test deltaRemove()
+ * @test deltaMove()
+ */
+TEST(MoveDeltas, TentMoves){
+  Input input;
+  Board board = input.inputFromFile("../tests/test6.test");
+  std::mt19937 localGen(11);
+
+  auto counters = [](const Board &b) {
+    return std::vector<long>{(long)b.getRowViolations(), (long)b.getColViolations(), (long)b.getTentViolations(),
+                             (long)b.getTreeViolations(), (long)b.getLonelyTentViolations()};
+  };
+  auto expectDelta = [&](const std::vector<long> &before, const ViolationDelta &delta, int step) {
+    std::vector<long> after = counters(board);
+    EXPECT_EQ(after[0] - before[0], delta.row) << "step " << step;
+    EXPECT_EQ(after[1] - before[1], delta.col) << "step " << step;
+    EXPECT_EQ(after[2] - before[2], delta.tent) << "step " << step;
+    EXPECT_EQ(after[3] - before[3], delta.tree) << "step " << step;
+    EXPECT_EQ(after[4] - before[4], delta.lonely) << "step " << step;
+  };
+
+  for (int i = 0; i < 3000; i++) {
+    std::vector<long> before = counters(board);
+    std::optional<Coord> open = board.randomOpenTile(localGen);
+    std::optional<Coord> tent = board.randomTent(localGen);
+    int kind = i % 4;
+
+    if ((kind == 0 || !tent) && open) {
+      char dir = board.chooseTreeDir(*open, localGen);
+      ViolationDelta delta = board.deltaAdd(*open, dir);
+      board.placeTent(*open, dir);
+      expectDelta(before, delta, i);
+    } else if (kind == 1) {
+      ViolationDelta delta = board.deltaRemove(*tent);
+      board.deleteTent(*tent);
+      expectDelta(before, delta, i);
+    } else if (kind == 2 && open) {
+      char dir = board.chooseTreeDir(*open, localGen);
+      ViolationDelta delta = board.deltaMove(*tent, *open, dir);
+      board.moveTent(*tent, *open, dir);
+      expectDelta(before, delta, i);
+    } else {
+      // Re-associate the tent with whatever tree it borders, including ones that already have tents.
+      const char dirs[5] = {'X', 'U', 'D', 'L', 'R'};
+      char dir = dirs[localGen() % 5];
+      ViolationDelta delta = board.deltaMove(*tent, *tent, dir);
+      board.moveTent(*tent, *tent, dir);
+      expectDelta(before, delta, i);
+    }
+  }
+}
+
+/**
+ * @brief The lazily replayed best board must match the best violation count the annealer reports
+ * @test Annealer::run()
+ * @test Annealer::getBestBoard()
+ */
+TEST(AnnealerBest, Annealer){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  std::string path = "../tests/test5.test";
+  Annealer annealer(path.data(), board, 2.0, 0.05, 1.0, 5);
+
+  // Enough moves at several temperatures to overflow the journal and fall back to cloning.
+  for (double temperature : {3.0, 1.0, 0.3, 0.1, 0.05}) {
+    annealer.run(50000, temperature);
+    const Board &best = annealer.getBestBoard();
+    EXPECT_EQ(best.getViolations(), annealer.getBestViolations());
+    EXPECT_LE(annealer.getBestViolations(), annealer.getViolations());
+
+    Board rebuilt(best.getNumRows(), best.getNumCols(), best.getRowTentNum(), best.getColTentNum(), best.getBoard(), best.getNumTrees());
+    EXPECT_EQ(rebuilt.getViolations(), best.getViolations());
+  }
+  EXPECT_LT(annealer.getBestViolations(), board.getViolations());
+}
+
+/**
+ * @brief The matching seed must be a maximum matching and never make the starting board worse
+ * @test TentMatcher()
+ * @test TentMatcher::buildBoard()
+ */
+TEST(MatchingSeed, TentMatcher){
+  Input input;
+  Board board = input.inputFromFile("../tests/one.test");
+  TentMatcher matcher(board);
+  // Only the bottom row has quota, its cells (2, 0) and (2, 2) can serve the trees above and beside them.
+  EXPECT_EQ(matcher.getMatchingSize(), 2);
+
+  for (std::string filePath : {"../tests/test5.test", "../tests/test6.test", "../tests/hw5-2.test"}) {
+    Board start = input.inputFromFile(filePath);
+    TentMatcher seeded(start);
+    std::mt19937 localGen(1);
+    Board built = seeded.buildBoard(&localGen);
+    EXPECT_LT(built.getViolations(), start.getViolations()) << filePath;
+    EXPECT_LE(seeded.getMatchingSize(), start.getNumTrees()) << filePath;
+
+    Board rebuilt(built.getNumRows(), built.getNumCols(), built.getRowTentNum(), built.getColTentNum(), built.getBoard(), built.getNumTrees());
+    EXPECT_EQ(rebuilt.getViolations(), built.getViolations()) << filePath;
+  }
+}
+
+// Tries every placement (including every tree association) on a tiny board and returns the best violation count.
+static size_t bruteForceBest(Board &board, size_t cell) {
+  size_t cols = board.getNumCols();
+  if (cell == board.getNumTiles())
+    return board.getViolations();
+  size_t r = cell / cols, c = cell % cols;
+  size_t best = bruteForceBest(board, cell + 1);
+  if (board.getType(r, c) != Type::NONE)
+    return best;
+  for (char dir : {'X', 'U', 'D', 'L', 'R'}) {
+    board.placeTent(Coord(r, c), dir);
+    // Directions without a tree collapse onto 'X', skip the duplicates.
+    if (board.getDir(r, c) == dir)
+      best = std::min(best, bruteForceBest(board, cell + 1));
+    board.deleteTent(Coord(r, c));
+  }
+  return best;
+}
+
+/**
+ * @brief The exact solver must prove the same optimum an exhaustive search finds, and only write proven optima
+ * @test ExactSolver::run()
+ * @test ExactSolver::solve()
+ */
+TEST(ExactOptimum, ExactSolver){
+  Input input;
+  for (std::string filePath : {"../tests/one.test", "../tests/hw5-2.test", "../tests/hw5-3.test", "../tests/ninetiletree.test", "../tests/twotile.test"}) {
+    Board board = input.inputFromFile(filePath);
+    Board scratch = board;
+    size_t expected = bruteForceBest(scratch, 0);
+
+    ExactSolver solver(filePath.data(), board);
+    EXPECT_TRUE(solver.run()) << filePath;
+    EXPECT_EQ(solver.getBestViolations(), expected) << filePath;
+    EXPECT_EQ(solver.getBestBoard().getViolations(), expected) << filePath;
+  }
+
+  // Stopped by the node limit, solve() keeps its incumbent for the caller and writes no output.
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "exact_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::filesystem::copy_file("../tests/test6.test", dir / "test6.test");
+  std::string path = (dir / "test6.test").string();
+  Board board = input.inputFromFile(path);
+  ExactSolver limited(path.data(), board, 10);
+  size_t best = limited.solve();
+  EXPECT_EQ(best, limited.getBestBoard().getViolations());
+  EXPECT_FALSE(limited.isOptimal());
+  ExactSolver timed(path.data(), board);
+  timed.setTimeLimit(1e-6);
+  EXPECT_FALSE(timed.run());
+  EXPECT_LT(timed.getNodeCount(), ExactSolver::DEFAULT_NODE_LIMIT);
+  EXPECT_LE(timed.getBestViolations(), board.getViolations());
+  flushSolutions();
+  EXPECT_FALSE(std::filesystem::exists(outputDirectory(path.c_str())));
+  std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Clusters partition the candidate cells and never touch each other
+ * @test ClusterSolver()
+ * @test ClusterSolver::solve()
+ */
+TEST(Decomposition, ClusterSolver){
+  Input input;
+  for (std::string filePath : {"../tests/test5.test", "../tests/test6.test"}) {
+    Board board = input.inputFromFile(filePath);
+    ClusterSolver solver(board, 1);
+    const std::vector<ClusterSolver::Cluster>& clusters = solver.getClusters();
+    ASSERT_FALSE(clusters.empty()) << filePath;
+
+    size_t cols = board.getNumCols();
+    std::vector<int> clusterOf(board.getNumTiles(), -1);
+    for (size_t k = 0; k < clusters.size(); k++) {
+      EXPECT_FALSE(clusters[k].trees.empty());
+      for (size_t cell : clusters[k].cells) {
+        EXPECT_EQ(board.getType(cell / cols, cell % cols), Type::NONE);
+        EXPECT_EQ(clusterOf[cell], -1) << "cell " << cell << " is in two clusters";
+        clusterOf[cell] = k;
+      }
+    }
+    for (size_t cell = 0; cell < clusterOf.size(); cell++) {
+      if (clusterOf[cell] == -1)
+        continue;
+      int r = cell / cols, c = cell % cols;
+      for (int dr = -1; dr <= 1; dr++) {
+        for (int dc = -1; dc <= 1; dc++) {
+          int nr = r + dr, nc = c + dc;
+          if (nr < 0 || nc < 0 || nr >= (int)board.getNumRows() || nc >= (int)cols)
+            continue;
+          int other = clusterOf[nr * cols + nc];
+          EXPECT_TRUE(other == -1 || other == clusterOf[cell]) << filePath;
+        }
+      }
+    }
+
+    Board solved = solver.solve(0.1);
+    Board rebuilt(solved.getNumRows(), solved.getNumCols(), solved.getRowTentNum(), solved.getColTentNum(), solved.getBoard(), solved.getNumTrees());
+    EXPECT_EQ(rebuilt.getViolations(), solved.getViolations()) << filePath;
+    EXPECT_LT(solved.getViolations(), board.getViolations()) << filePath;
+  }
+}
+
+/**
+ * @brief The native verifier agrees with autograder.py on the sample outputs and rejects what it rejects
+ * @test Verifier::verify()
+ * @test Verifier::verifyText()
+ */
+TEST(OutputChecks, Verifier){
+  Input input;
+  Board board = input.inputFromFile("../tests/one.test");
+  Verifier verifier(board);
+
+  Verifier::Result result = verifier.verify("../tests/one.out");
+  EXPECT_TRUE(result.matches());
+  EXPECT_EQ(result.violations, 11);
+  EXPECT_EQ(result.tents, 4);
+  result = verifier.verify("../tests/oneALT.out");
+  EXPECT_TRUE(result.matches());
+  EXPECT_EQ(result.violations, 10);
+
+  // Claiming the wrong count is valid but does not match.
+  Board scratch = board;
+  result = verifier.verifyText("9\n1\n1 1 R\n", scratch);
+  EXPECT_TRUE(result.valid);
+  EXPECT_FALSE(result.matches());
+
+  std::vector<std::pair<std::string, std::string>> cases = {
+    {"5\n", "Output file format error: Not enough lines."},
+    {"5\nfour\n", "Output file format error: First two lines must be integers."},
+    {"5\n1\n1 1\n", "Output file format error: Each operation line must have 3 values (row, col, symbol)."},
+    {"5\n1\n1 a R\n", "Output file format error: Row and column values must be integers."},
+    {"5\n1\n4 1 R\n", "Operation (4, 1) is out of grid bounds."},
+    {"5\n1\n1 1 Q\n", "Output file format error: Symbol must be one of U, D, L, R, or X."},
+    {"5\n1\n1 2 X\n", "Cannot place tent on a tree, invalid operation"},
+    {"5\n1\n1 1 U\n", "Operation (1, 1) with symbol U is invalid: tree position out of bounds."},
+    {"5\n1\n1 3 R\n", "Operation (1, 3) with symbol R is invalid: no tree found in the expected direction."},
+    {"5\n2\n1 1 R\n1 1 R\n", "Operation (1, 1) places a second tent on the same cell."},
+  };
+  for (const auto& [text, message] : cases) {
+    result = verifier.verifyText(text, scratch);
+    EXPECT_FALSE(result.valid) << text;
+    EXPECT_EQ(result.error, message) << text;
+  }
+}
+
+/**
+ * @brief Word-parallel cell copies leave every counter as a fresh board would compute it
+ * @test Board::copyCellsFrom()
+ */
+TEST(CopyCells, Crossover){
+  Input input;
+  Board board = input.inputFromFile("../tests/test6.test");
+  TentMatcher matcher(board);
+  std::mt19937 gen1(1), gen2(2);
+  Board parent1 = matcher.buildBoard(&gen1);
+  Board parent2 = matcher.buildBoard(&gen2);
+  size_t numTiles = board.getNumTiles();
+
+  Board child = parent1;
+  child.copyCellsFrom(parent2, 0, numTiles);
+  EXPECT_EQ(child.getCells(), parent2.getCells());
+  EXPECT_EQ(child.getViolations(), parent2.getViolations());
+
+  // Odd bounds exercise the partial words at both ends, the mask keeps only every third cell.
+  std::vector<uint64_t> mask((numTiles + 63) / 64, 0);
+  for (size_t i = 0; i < numTiles; i += 3)
+    mask[i / 64] |= uint64_t(1) << (i % 64);
+  size_t begin = 13, end = numTiles - 29;
+  child.cloneFrom(parent1);
+  child.copyCellsFrom(parent2, begin, end, mask.data());
+  for (size_t i = 0; i < numTiles; i++) {
+    bool taken = i >= begin && i < end && i % 3 == 0;
+    EXPECT_EQ(child.getCells()[i], (taken ? parent2 : parent1).getCells()[i]) << i;
+  }
+  Board rebuilt(child.getNumRows(), child.getNumCols(), child.getRowTentNum(), child.getColTentNum(), child.getCells());
+  EXPECT_EQ(child.getViolations(), rebuilt.getViolations());
+  EXPECT_EQ(child.getTentViolations(), rebuilt.getTentViolations());
+  EXPECT_EQ(child.getTreeViolations(), rebuilt.getTreeViolations());
+  EXPECT_EQ(child.getTentTilesData().size(), rebuilt.getTentTilesData().size());
+}
+
+/**
+ * @brief Every XOR-popcount kernel the build has agrees with the scalar one, and board distances follow tents
+ * @test BitVector::hamming()
+ * @test Board::hammingDistance()
+ */
+TEST(Kernels, BitVector){
+  std::mt19937_64 gen(7);
+  for (size_t bits : {1, 63, 64, 511, 512, 513, 100000}) {
+    BitVector a(bits), b(bits);
+    for (size_t i = 0; i < bits; i++) {
+      if (gen() & 1) a.set(i);
+      if (gen() % 3 == 0) b.set(i);
+    }
+    size_t expected = 0;
+    for (size_t i = 0; i < bits; i++)
+      expected += a.test(i) != b.test(i);
+
+    EXPECT_EQ(a.numWords() % BitVector::WORDS_PER_LINE, 0) << bits;
+    EXPECT_EQ(BitVector::xorPopcountScalar(a.data(), b.data(), a.numWords()), expected) << bits;
+#if defined(__AVX2__)
+    EXPECT_EQ(BitVector::xorPopcountAvx2(a.data(), b.data(), a.numWords()), expected) << bits;
+#endif
+#if defined(__AVX512F__) && defined(__AVX512VPOPCNTDQ__)
+    EXPECT_EQ(BitVector::xorPopcountAvx512(a.data(), b.data(), a.numWords()), expected) << bits;
+#endif
+    EXPECT_EQ(a.hamming(b), expected) << bits;
+  }
+
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  Board other = board;
+  EXPECT_EQ(board.hammingDistance(other), 0);
+  other.placeTent(Coord(0, 0), 'X');
+  other.placeTent(Coord(2, 2), 'X');
+  EXPECT_EQ(board.hammingDistance(other), 2);
+  EXPECT_EQ(other.getBitBoard().count(), other.getTentTilesData().size());
+}
+
+/**
+ * @brief Cached population distances against pairwise Hamming distances
+ * @test DiversityMatrix::compute()
+ * @test DiversityMatrix::nicheCounts()
+ */
+TEST(PairwiseDistances, DiversityMatrix){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  TentMatcher matcher(board);
+  std::mt19937 gen(3);
+
+  // More boards than one block, and a size that leaves a partial block
+  std::vector<Board> population;
+  for (size_t i = 0; i < 2 * DiversityMatrix::BLOCK + 3; i++)
+    population.push_back(matcher.buildBoard(&gen));
+  population.push_back(population[0]);
+
+  DiversityMatrix matrix;
+  matrix.compute(population);
+  ASSERT_EQ(matrix.size(), population.size());
+  for (size_t i = 0; i < population.size(); i++) {
+    EXPECT_EQ(matrix.distance(i, i), 0);
+    for (size_t j = 0; j < population.size(); j++)
+      EXPECT_EQ(matrix.distance(i, j), population[i].hammingDistance(population[j])) << i << " " << j;
+  }
+
+  std::vector<double> niches;
+  matrix.nicheCounts(0.0, niches);
+  EXPECT_EQ(niches, std::vector<double>(population.size(), 1.0));
+
+  // Radius 1 only counts identical boards, the first and last are the same
+  matrix.nicheCounts(1.0, niches);
+  EXPECT_DOUBLE_EQ(niches[0], 2.0);
+  EXPECT_DOUBLE_EQ(niches.back(), 2.0);
+  EXPECT_GE(niches[1], 1.0);
+}
+
+/**
+ * @brief Bounded single-producer single-consumer queue, alone and across two threads
+ * @test SpscQueue::tryPush()
+ * @test SpscQueue::tryPop()
+ */
+TEST(Migration, SpscQueue){
+  SpscQueue<int, 4> queue;
+  int value = -1;
+  EXPECT_FALSE(queue.tryPop(value));
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(queue.tryPush(i));
+  EXPECT_FALSE(queue.tryPush(4));
+  EXPECT_TRUE(queue.tryPop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(queue.tryPush(4));
+  for (int i = 1; i <= 4; i++) {
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_EQ(value, i);
+  }
+
+  // Everything arrives once and in order
+  SpscQueue<int, 8> channel;
+  // Both sides yield when blocked so the test stays quick on a single core
+  const int count = 100000;
+  std::thread producer([&channel]() {
+    for (int i = 0; i < count; i++)
+      while (!channel.tryPush(i))
+        std::this_thread::yield();
+  });
+  int expected = 0;
+  while (expected < count) {
+    if (channel.tryPop(value))
+      ASSERT_EQ(value, expected++);
+    else
+      std::this_thread::yield();
+  }
+  producer.join();
+  EXPECT_FALSE(channel.tryPop(value));
+}
+
+/**
+ * @brief Islands breed on their own and hand back a board at least as good as the empty one
+ * @test TTSolver::runIslands()
+ */
+TEST(IslandModel, TTSolver){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  std::string path = "../tests/test5.test";
+  TTSolver solver(path.data(), 40, 1000, board, 1, 0, 0, 4, 40);
+  solver.setIslands(4, TTSolver::Topology::RANDOM, 2);
+
+  Board best = solver.runIslands(20);
+  EXPECT_LE(best.getViolations(), board.getViolations());
+  EXPECT_LE(solver.islandGenerations(), 4 * 20);
+  EXPECT_GE(solver.islandGenerations(), 4);
+  EXPECT_EQ(best.getNumTiles(), board.getNumTiles());
+
+  // Too small to split, it runs as one island that still keeps an elite.
+  TTSolver tiny(path.data(), 2, 1000, board, 1, 0, 0, 4, 40);
+  tiny.setIslands(4);
+  EXPECT_LE(tiny.runIslands(5).getViolations(), board.getViolations());
+  EXPECT_EQ(tiny.islandGenerations(), 5);
+}
+
+/**
+ * @brief Steady-state breeding holds one population plus two scratch boards per thread
+ * @test TTSolver::setSteadyState()
+ * @test TTSolver::residentBoards()
+ */
+TEST(SteadyState, TTSolver){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  std::string path = "../tests/test5.test";
+
+  TTSolver generational(path.data(), 30, 1000, board, 1, 0, 0, 4, 40);
+  generational.runGenerations(1);
+  EXPECT_EQ(generational.residentBoards(), 60);
+
+  TTSolver steady(path.data(), 30, 1000, board, 1, 0, 0, 4, 40);
+  steady.setSteadyState(true);
+  size_t first = steady.runGenerations(1);
+  EXPECT_EQ(steady.residentBoards(), 30 + 2 * static_cast<size_t>(omp_get_max_threads()));
+  EXPECT_LE(first, board.getViolations());
+}
+
+/**
+ * @brief Once warmed up, steady-state generations breed entirely in recycled board buffers
+ * @test TTSolver::step()
+ */
+TEST(RecycledBuffers, TTSolver){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  std::string path = "../tests/test5.test";
+  TTSolver solver(path.data(), 30, 1000, board, 1, 0, 0, 4, 40);
+  solver.setSteadyState(true);
+  solver.runGenerations(20);
+
+  allocationCount = 0;
+  largestAllocation = 0;
+  countAllocations = true;
+  solver.step(5);
+  countAllocations = false;
+  EXPECT_EQ(allocationCount.load(), 0) << "largest " << largestAllocation.load() << " bytes";
+}
+
+/**
+ * @brief Sparse set membership, swap-with-last removal and copies
+ * @test TilesSet::insert()
+ * @test TilesSet::remove()
+ * @test TilesSet::getTileAtIndex()
+ */
+TEST(SparseSet, TilesSet){
+  TilesSet set(3, 4);
+  EXPECT_TRUE(set.insert(Coord(0, 0)));
+  EXPECT_TRUE(set.insert(Coord(1, 2)));
+  EXPECT_TRUE(set.insert(Coord(2, 3)));
+  EXPECT_FALSE(set.insert(Coord(1, 2)));
+  EXPECT_EQ(set.size(), 3);
+
+  // The last member fills the removed slot
+  EXPECT_TRUE(set.remove(Coord(0, 0)));
+  EXPECT_FALSE(set.remove(Coord(0, 0)));
+  EXPECT_EQ(set.getTileAtIndex(0), Coord(2, 3));
+  EXPECT_EQ(set.getTileAtIndex(1), Coord(1, 2));
+  EXPECT_EQ(set.getTileAtIndex(2), std::nullopt);
+  EXPECT_FALSE(set.contains(Coord(0, 0)));
+  EXPECT_TRUE(set.contains(Coord(2, 3)));
+
+  TilesSet copy = set;
+  EXPECT_TRUE(copy.remove(Coord(2, 3)));
+  EXPECT_TRUE(copy.insert(Coord(0, 1)));
+  EXPECT_TRUE(set.contains(Coord(2, 3)));
+  EXPECT_FALSE(set.contains(Coord(0, 1)));
+  EXPECT_EQ(copy.size(), 2);
+}
+
+/**
+ * @brief Conflict sets must match a brute-force recount after random moves and a clone
+ * @test getTouchingTents()
+ * @test getLonelyTents()
+ * @test getLonelyTrees()
+ * @test getOffRows()
+ * @test getOffCols()
+ */
+TEST(ConflictSets, BoardUnitTests){
+  Input input;
+  Board board = input.inputFromFile("../tests/test5.test");
+  Board clone = input.inputFromFile("../tests/one.test");
+  std::mt19937 localGen(5);
+
+  auto recount = [](const Board& b) {
+    size_t touching = 0, lonelyTents = 0, lonelyTrees = 0, offRows = 0, offCols = 0;
+    for (size_t r = 0; r < b.getNumRows(); r++) {
+      for (size_t c = 0; c < b.getNumCols(); c++) {
+        Coord at(r, c);
+        if (b.getType(r, c) == Type::TENT) {
+          bool touches = false;
+          for (int dr = -1; dr <= 1; dr++)
+            for (int dc = -1; dc <= 1; dc++) {
+              long nr = (long)r + dr, nc = (long)c + dc;
+              if ((dr || dc) && nr >= 0 && nc >= 0 && nr < (long)b.getNumRows() && nc < (long)b.getNumCols()
+                  && b.getType(nr, nc) == Type::TENT)
+                touches = true;
+            }
+          EXPECT_EQ(b.getTouchingTents().contains(at), touches) << r << "," << c;
+          EXPECT_EQ(b.getLonelyTents().contains(at), b.getDir(r, c) == 'X') << r << "," << c;
+          touching += touches;
+          lonelyTents += b.getDir(r, c) == 'X';
+        } else if (b.getType(r, c) == Type::TREE) {
+          bool lonely = b.getTreeTentCount()[r * b.getNumCols() + c] == 0;
+          EXPECT_EQ(b.getLonelyTrees().contains(at), lonely) << r << "," << c;
+          lonelyTrees += lonely;
+        }
+      }
+    }
+    for (size_t r = 0; r < b.getNumRows(); r++)
+      offRows += b.getCurrentRowTents()[r] != b.getRowTentNum()[r];
+    for (size_t c = 0; c < b.getNumCols(); c++)
+      offCols += b.getCurrentColTents()[c] != b.getColTentNum()[c];
+    EXPECT_EQ(b.getTouchingTents().size(), touching);
+    EXPECT_EQ(b.getLonelyTents().size(), lonelyTents);
+    EXPECT_EQ(b.getLonelyTrees().size(), lonelyTrees);
+    EXPECT_EQ(b.getOffRows().size(), offRows);
+    EXPECT_EQ(b.getOffCols().size(), offCols);
+  };
+
+  recount(board);
+  for (int i = 0; i < 3000; i++) {
+    if (i % 4 == 0)
+      board.removeTent(localGen);
+    else if (i % 4 == 1)
+      board.moveTent(localGen);
+    else
+      board.addTent(localGen);
+  }
+  recount(board);
+
+  clone.cloneFrom(board);
+  clone.removeTent(localGen);
+  recount(clone);
+}
+
+/**
+ * @brief Re-pairing keeps every tent in place, follows augmenting paths, reaches a maximum tent-tree matching
+ * and groups leftover lonely tents on a shared tree
+ * @test claimTree()
+ * @test repairPairing()
+ * @test optimisePairing()
+ */
+TEST(TreePairing, BoardUnitTests){
+  // T a T b: a holds the right tree and b is lonely, b can only pair if a moves over to the left tree
+  std::vector<std::vector<Tile>> row = {{
+    Tile(Type::TREE, 0, 0), Tile(Type::TENT, 0, 1, 'R'), Tile(Type::TREE, 0, 2), Tile(Type::TENT, 0, 3, 'X')
+  }};
+  Board chain(1, 4, {2}, {0, 1, 0, 1}, row, 2);
+  EXPECT_FALSE(chain.repairPairing(Coord(0, 1), 4));
+  EXPECT_FALSE(chain.repairPairing(Coord(0, 3), 1));
+  EXPECT_TRUE(chain.repairPairing(Coord(0, 3), 2));
+  EXPECT_EQ(chain.getDir(0, 1), 'L');
+  EXPECT_EQ(chain.getDir(0, 3), 'L');
+  EXPECT_EQ(chain.getTreeViolations() + chain.getLonelyTents().size(), 0);
+
+  Board lonely(1, 4, {2}, {0, 1, 0, 1}, row, 2);
+  EXPECT_FALSE(lonely.claimTree(Coord(0, 2)));
+  lonely.deleteTent(Coord(0, 1));
+  EXPECT_TRUE(lonely.claimTree(Coord(0, 2)));
+  EXPECT_EQ(lonely.getDir(0, 3), 'L');
+
+  // T is paired from above and two 'X' tents stand beside it with no other tree: both joining T trades two lonely
+  // tents for one overloaded tree, the fewest violations any choice of directions reaches
+  std::vector<std::vector<Tile>> grid = {
+    {Tile(Type::NONE, 0, 0), Tile(Type::TENT, 0, 1, 'D'), Tile(Type::NONE, 0, 2)},
+    {Tile(Type::TENT, 1, 0, 'X'), Tile(Type::TREE, 1, 1), Tile(Type::TENT, 1, 2, 'X')},
+    {Tile(Type::NONE, 2, 0), Tile(Type::NONE, 2, 1), Tile(Type::NONE, 2, 2)}
+  };
+  Board group(3, 3, {1, 2, 0}, {1, 1, 1}, grid, 1);
+  Coord tents[3] = {Coord(0, 1), Coord(1, 0), Coord(1, 2)};
+  size_t fewest = group.getViolations();
+  for (int choice = 0; choice < 125; choice++) {
+    Board trial = group;
+    for (int t = 0, rest = choice; t < 3; t++, rest /= 5)
+      trial.moveTent(tents[t], tents[t], "XUDLR"[rest % 5]);
+    fewest = std::min(fewest, trial.getViolations());
+  }
+  group.optimisePairing();
+  EXPECT_EQ(group.getViolations(), fewest);
+  EXPECT_EQ(group.getTreeTentCount()[4], 3);
+  EXPECT_EQ(group.getLonelyTents().size(), 0);
+
+  // Scatter lonely tents, then compare the pairing with a brute-force maximum matching
+  Input input;
+  Board board = input.inputFromFile("../tests/test6.test");
+  std::mt19937 localGen(9);
+  for (int i = 0; i < 250; i++)
+    board.placeTent(*board.randomOpenTile(localGen), 'X');
+  std::vector<uint8_t> cellsBefore = board.getCells();
+  size_t before = board.getViolations();
+  size_t removed = board.optimisePairing();
+  EXPECT_EQ(before - removed, board.getViolations());
+
+  size_t rows = board.getNumRows(), cols = board.getNumCols();
+  // Only directions change, the type bits of every cell stay the same
+  for (size_t i = 0; i < rows * cols; i++)
+    EXPECT_EQ(board.getCells()[i] & 0x3, cellsBefore[i] & 0x3);
+
+  std::vector<long> treeOwner(rows * cols, -1);
+  std::vector<int> seen(rows * cols, 0);
+  int round = 0;
+  std::function<bool(size_t)> augment = [&](size_t tent) {
+    long r = tent / cols, c = tent % cols;
+    for (auto [dr, dc] : {std::pair{-1, 0}, {1, 0}, {0, -1}, {0, 1}}) {
+      long nr = r + dr, nc = c + dc;
+      if (nr < 0 || nc < 0 || nr >= (long)rows || nc >= (long)cols || board.getType(nr, nc) != Type::TREE)
+        continue;
+      size_t tree = nr * cols + nc;
+      if (seen[tree] == round)
+        continue;
+      seen[tree] = round;
+      if (treeOwner[tree] < 0 || augment(treeOwner[tree])) {
+        treeOwner[tree] = tent;
+        return true;
+      }
+    }
+    return false;
+  };
+  size_t matching = 0;
+  for (size_t i = 0; i < rows * cols; i++) {
+    if (board.getType(i / cols, i % cols) != Type::TENT)
+      continue;
+    round++;
+    matching += augment(i);
+  }
+
+  // Picking one tent per covered tree is a matching, so a maximum one covers exactly this many trees; grouping
+  // lonely tents only adds tents to trees that are covered already
+  size_t covered = 0, paired = 0;
+  for (size_t i = 0; i < rows * cols; i++) {
+    covered += board.getType(i / cols, i % cols) == Type::TREE && board.getTreeTentCount()[i] >= 1;
+    paired += board.getType(i / cols, i % cols) == Type::TREE && board.getTreeTentCount()[i] == 1;
+  }
+  EXPECT_EQ(covered, matching);
+  EXPECT_LE(paired, matching);
+
+  Board rebuilt(rows, cols, board.getRowTentNum(), board.getColTentNum(), board.getBoard(), board.getNumTrees());
+  EXPECT_EQ(rebuilt.getViolations(), board.getViolations());
+  EXPECT_EQ(rebuilt.getTreeViolations(), board.getTreeViolations());
+}
+
+/**
+ * @brief The reporter writes one line per interval plus a final one, from whatever was published last,
+ * and never lets the evaluation count go backwards
+ * @test ProgressReporter::publish()
+ */
+TEST(RateLimited, ProgressReporter){
+  std::ostringstream text;
+  {
+    ProgressReporter reporter(text, std::chrono::milliseconds(20), ProgressReporter::Format::TEXT, "board");
+    reporter.publish(3, 42, 300, 12.5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(70));
+    reporter.publish(7, 40, 700, -1.0);
+  }
+  std::string lines = text.str();
+  size_t count = std::count(lines.begin(), lines.end(), '\n');
+  EXPECT_GE(count, 2);
+  EXPECT_LE(count, 6);
+  EXPECT_NE(lines.find("board gen=3 best=42"), std::string::npos);
+  EXPECT_NE(lines.find("diversity=12.5"), std::string::npos);
+  // The final line carries the last publish, and no diversity when it is unknown
+  std::string last = lines.substr(lines.rfind('\n', lines.size() - 2) + 1);
+  EXPECT_EQ(last.rfind("board gen=7 best=40", 0), 0);
+  EXPECT_EQ(last.find("diversity"), std::string::npos);
+
+  // Islands publish out of order, an older, smaller total must not turn the rate negative (or huge).
+  std::ostringstream racing;
+  {
+    ProgressReporter reporter(racing, std::chrono::milliseconds(20), ProgressReporter::Format::TEXT, "islands");
+    reporter.publish(2, 5, 1000, -1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reporter.publish(1, 5, 400, -1.0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  std::istringstream racingLines(racing.str());
+  for (std::string line; std::getline(racingLines, line);) {
+    size_t at = line.find("evals/s=");
+    ASSERT_NE(at, std::string::npos) << line;
+    EXPECT_LT(std::stod(line.substr(at + 8)), 1e6) << line;
+  }
+
+  std::ostringstream json;
+  {
+    ProgressReporter reporter(json, std::chrono::seconds(10), ProgressReporter::Format::JSON, "a\"b");
+    reporter.publish(1, 9, 100, -1.0);
+  }
+  EXPECT_EQ(json.str().rfind("{\"label\":\"a\\\"b\",\"generation\":1,\"best\":9,", 0), 0);
+  EXPECT_NE(json.str().find("\"diversity\":null"), std::string::npos);
+}
+
+/**
+ * @brief Solutions are formatted in one buffer and land on disk whole, synchronously or from the writer thread
+ * @test formatSolution()
+ * @test writeFileAtomic()
+ * @test writeSolutionAsync()
+ */
+TEST(FastWriter, Output){
+  std::vector<std::vector<Tile>> row = {{
+    Tile(Type::TREE, 0, 0), Tile(Type::TENT, 0, 1, 'L'), Tile(Type::NONE, 0, 2), Tile(Type::TENT, 0, 3, 'X')
+  }};
+  Board board(1, 4, {2}, {0, 1, 0, 1}, row, 1);
+  std::string buffer = "stale contents that must go";
+  formatSolution(board, buffer);
+  EXPECT_EQ(buffer, "1\n2\n1 2 L\n1 4 X\n");
+
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "fast_writer_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  ASSERT_TRUE(writeFileAtomic(dir / "direct.out", buffer));
+  EXPECT_FALSE(std::filesystem::exists(dir / "direct.out.tmp"));
+  std::ifstream direct(dir / "direct.out");
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(direct), {}), buffer);
+
+  std::string input = (dir / "board.test").string();
+  writeSolutionAsync(input.c_str(), board);
+  // The queued copy is already formatted, later moves must not show up in the file
+  board.deleteTent(Coord(0, 3));
+  flushSolutions();
+  std::vector<std::filesystem::path> written;
+  for (const auto& entry : std::filesystem::directory_iterator(dir / "board_output"))
+    written.push_back(entry.path());
+  ASSERT_EQ(written.size(), 1);
+  EXPECT_EQ(written[0].extension(), ".out");
+  std::ifstream async(written[0]);
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(async), {}), "1\n2\n1 2 L\n1 4 X\n");
+  std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Snapshots round trip the population, reject damaged or foreign data, and a stop request ends solve() with one
+ * @test Snapshot::encode()
+ * @test Snapshot::decode()
+ * @test writeFileAsync()
+ * @test TTSolver::setSnapshots()
+ * @test TTSolver::setResume()
+ */
+TEST(Checkpoint, Snapshot){
+  Input input;
+  Board empty = input.inputFromFile("../tests/test6.test");
+  std::vector<Board> boards = {TentMatcher(empty).buildBoard(), empty};
+  std::string buffer;
+  Snapshot::encode(boards, 7, 3, "42 17", buffer);
+
+  std::optional<Snapshot> decoded = Snapshot::decode(buffer, empty);
+  ASSERT_TRUE(decoded);
+  EXPECT_EQ(decoded->generation, 7);
+  EXPECT_EQ(decoded->stale, 3);
+  EXPECT_EQ(decoded->randomState, "42 17");
+  ASSERT_EQ(decoded->boards.size(), 2);
+  for (size_t b = 0; b < boards.size(); b++) {
+    EXPECT_EQ(decoded->boards[b].getViolations(), boards[b].getViolations());
+    for (size_t r = 0; r < empty.getNumRows(); r++)
+      for (size_t c = 0; c < empty.getNumCols(); c++)
+        EXPECT_EQ(decoded->boards[b].getDir(r, c), boards[b].getDir(r, c));
+  }
+
+  std::string damaged = buffer;
+  damaged[damaged.size() / 2] ^= 1;
+  EXPECT_FALSE(Snapshot::decode(damaged, empty));
+  EXPECT_FALSE(Snapshot::decode(buffer, input.inputFromFile("../tests/test5.test")));
+  EXPECT_FALSE(Snapshot::looksLikeSnapshot("0\n0\n"));
+
+  // Queued writes to the same file collapse into the newest one
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "checkpoint_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  writeFileAsync(dir / "coalesced", "old");
+  writeFileAsync(dir / "coalesced", "new");
+  flushSolutions();
+  std::ifstream coalesced(dir / "coalesced");
+  EXPECT_EQ(std::string(std::istreambuf_iterator<char>(coalesced), {}), "new");
+
+  std::filesystem::copy_file("../tests/test5.test", dir / "test5.test");
+  std::string path = (dir / "test5.test").string();
+  Board board = input.inputFromFile(path);
+  TTSolver stopped(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+  stopped.setSnapshots(dir / "test5.snap", 3600.0);
+  requestStop();
+  size_t best = stopped.solve();
+  requestStop(false);
+  flushSolutions();
+  ASSERT_TRUE(std::filesystem::exists(dir / "test5.snap"));
+
+  TTSolver resumed(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+  resumed.setResume((dir / "test5.snap").string());
+  EXPECT_EQ(resumed.runGenerations(0), best);
+
+  // A seeded run resumed from its snapshot breeds the same generations the original would have bred next.
+  TTSolver seeded(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+  seeded.setSeed(9);
+  seeded.setEvaluationLimit(30 * 5);
+  seeded.setSnapshots(dir / "seeded.snap", 3600.0);
+  seeded.solve();
+  flushSolutions();
+  seeded.step(5);
+  TTSolver continued(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+  continued.setResume((dir / "seeded.snap").string());
+  continued.runGenerations(5);
+  EXPECT_EQ(continued.getBestBoard().hammingDistance(seeded.getBestBoard()), 0);
+  std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Earlier solutions come back best first, invalid ones are skipped, and only strict improvements get written
+ * @test WarmStart::load()
+ * @test keepImprovementsOnly()
+ */
+TEST(TopSolutions, WarmStart){
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "warm_start_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir / "test5_output");
+  std::filesystem::copy_file("../tests/test5.test", dir / "test5.test");
+  std::string path = (dir / "test5.test").string();
+  Input input;
+  Board empty = input.inputFromFile(path);
+  Board matched = TentMatcher(empty).buildBoard();
+  ASSERT_LT(matched.getViolations(), empty.getViolations());
+
+  std::string buffer;
+  formatSolution(empty, buffer);
+  ASSERT_TRUE(writeFileAtomic(dir / "test5_output" / "empty.out", buffer));
+  formatSolution(matched, buffer);
+  ASSERT_TRUE(writeFileAtomic(dir / "test5_output" / "matched.out", buffer));
+  ASSERT_TRUE(writeFileAtomic(dir / "test5_output" / "broken.out", "0\n1\n999 999 X\n"));
+
+  WarmStart warm = WarmStart::load(path.c_str(), empty, 5);
+  EXPECT_EQ(warm.scanned, 3);
+  EXPECT_EQ(warm.rejected, 1);
+  ASSERT_EQ(warm.boards.size(), 2);
+  EXPECT_EQ(warm.boards[0].getViolations(), matched.getViolations());
+  EXPECT_EQ(warm.boards[1].getViolations(), empty.getViolations());
+  EXPECT_EQ(WarmStart::load(path.c_str(), empty, 1).boards.size(), 1);
+
+  keepImprovementsOnly(path.c_str(), matched.getViolations());
+  writeSolutionAsync(path.c_str(), empty);
+  writeSolutionAsync(path.c_str(), matched);
+  flushSolutions();
+  EXPECT_EQ(WarmStart::load(path.c_str(), empty, 5).scanned, 3);
+
+  keepImprovementsOnly(path.c_str(), matched.getViolations() + 1);
+  writeSolutionAsync(path.c_str(), matched);
+  writeSolutionAsync(path.c_str(), matched);
+  flushSolutions();
+  EXPECT_EQ(WarmStart::load(path.c_str(), empty, 5).scanned, 4);
+  std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief Rounds go to the input that keeps improving, never overlap on one input, and stop with the budget
+ * @test BatchScheduler::collectInputs()
+ * @test BatchScheduler::run()
+ */
+TEST(AdaptiveRounds, BatchScheduler){
+  std::vector<std::string> inputs = BatchScheduler::collectInputs({"../tests", "../tests/test5.test"});
+  EXPECT_EQ(inputs.back(), "../tests/test5.test");
+  EXPECT_TRUE(std::is_sorted(inputs.begin(), inputs.end() - 1));
+  EXPECT_NE(std::find(inputs.begin(), inputs.end() - 1, "../tests/test6.test"), inputs.end() - 1);
+
+  BatchScheduler scheduler({"../tests/test5.test", "../tests/test6.test", "../tests/one.test", "missing.test"}, 0.5, 0.01, 1);
+  ASSERT_EQ(scheduler.getInstances().size(), 3);
+
+  // test5 gets a little better every round by laying down one more tent of its matching, test6 never does
+  // and one.test is solved by its first round
+  const BatchScheduler::Instance* first = scheduler.getInstances().data();
+  std::vector<Board> chain = {first->input};
+  Board matched = TentMatcher(first->input).buildBoard();
+  const TilesSet& matchedTents = matched.getTentTilesData();
+  for (size_t i = 0; i < matchedTents.size(); i++) {
+    Coord tent = *matchedTents.getTileAtIndex(i);
+    Board next = chain.back();
+    next.placeTent(tent, matched.getDir(tent.getRow(), tent.getCol()));
+    if (next.getViolations() < chain.back().getViolations())
+      chain.push_back(next);
+  }
+  ASSERT_GT(chain.size(), 2);
+
+  auto round = [&](BatchScheduler::Instance& instance, double seconds) {
+    size_t index = &instance - first;
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    if (index == 0)
+      return BatchScheduler::Round{chain[std::min(instance.rounds + 1, chain.size() - 1)]};
+    return BatchScheduler::Round{instance.best, index == 2};
+  };
+  auto start = std::chrono::steady_clock::now();
+  scheduler.run(round);
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const std::vector<BatchScheduler::Instance>& instances = scheduler.getInstances();
+  EXPECT_LT(elapsed, 0.5 + 0.1);
+  EXPECT_EQ(instances[2].rounds, 1);
+  EXPECT_TRUE(instances[2].solved);
+  EXPECT_GT(instances[1].rounds, 0);
+  EXPECT_GT(instances[0].rounds, 2 * instances[1].rounds);
+  EXPECT_EQ(instances[0].best.getViolations(), chain.back().getViolations());
+
+  // With more workers than inputs an input still never runs two rounds at once
+  BatchScheduler parallel({"../tests/test5.test", "../tests/test6.test"}, 0.1, 0.005, 4);
+  std::vector<std::atomic<bool>> busy(2);
+  std::atomic<int> overlaps{0};
+  parallel.run([&](BatchScheduler::Instance& instance, double seconds) {
+    size_t index = &instance - parallel.getInstances().data();
+    if (busy[index].exchange(true))
+      overlaps++;
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    busy[index] = false;
+    return BatchScheduler::Round{instance.best};
+  });
+  EXPECT_EQ(overlaps.load(), 0);
+  EXPECT_GT(parallel.getInstances()[0].rounds, 1);
+}
+
+/**
+ * @brief Seeded runs stopped by an evaluation or move budget come out identical
+ * @test TTSolver::setSeed()
+ * @test TTSolver::setEvaluationLimit()
+ * @test TTSolver::setSteadyState()
+ * @test Annealer::setMoveLimit()
+ */
+TEST(Deterministic, Budgets){
+  std::filesystem::path dir = std::filesystem::temp_directory_path() / "deterministic_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  std::filesystem::copy_file("../tests/test6.test", dir / "test6.test");
+  std::string path = (dir / "test6.test").string();
+  Input input;
+  Board board = input.inputFromFile(path);
+
+  auto runGenetic = [&]() {
+    TTSolver solver(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+    solver.setSeed(42);
+    solver.setEvaluationLimit(30 * 25);
+    solver.solve();
+    return solver.getBestBoard();
+  };
+  Board first = runGenetic();
+  Board second = runGenetic();
+  EXPECT_EQ(first.getViolations(), second.getViolations());
+  EXPECT_EQ(first.hammingDistance(second), 0);
+
+  // The budget counts children actually bred: 26 a generation past the 4 elites, 2 per thread and round in steady state.
+  auto generationsFor = [&](bool steady) {
+    std::ostringstream json;
+    {
+      ProgressReporter reporter(json, std::chrono::seconds(10), ProgressReporter::Format::JSON, "budget");
+      TTSolver solver(path.data(), 30, 1000000, board, 1, 0, 0, 4, 40);
+      solver.setSteadyState(steady);
+      solver.setSeed(42);
+      solver.setEvaluationLimit(30 * 25);
+      solver.setProgress(&reporter);
+      solver.solve();
+    }
+    size_t at = json.str().rfind("\"generation\":");
+    return std::stoul(json.str().substr(at + 13));
+  };
+  size_t threads = static_cast<size_t>(omp_get_max_threads());
+  size_t births = 2 * threads * std::max<size_t>(30 / (2 * threads), 1);
+  EXPECT_EQ(generationsFor(false), (30 * 25 + 25) / 26);
+  EXPECT_EQ(generationsFor(true), (30 * 25 + births - 1) / births);
+
+  auto runAnnealer = [&]() {
+    // A time limit of 0 is unlimited, the move limit alone ends the run.
+    Annealer annealer(path.data(), TentMatcher(board).buildBoard(), 2.0, 0.02, 0.0, 7);
+    annealer.setMoveLimit(50000);
+    annealer.anneal();
+    EXPECT_EQ(annealer.getMoveCount(), 50000);
+    return annealer.getBestBoard();
+  };
+  Board annealed = runAnnealer();
+  EXPECT_EQ(annealed.hammingDistance(runAnnealer()), 0);
+  flushSolutions();
+  std::filesystem::remove_all(dir);
+}
+
+/**
+ * @brief A seeded ladder under a move limit shares a best board the verifier and a recount agree on,
+ * and exchanges only move replicas between rungs without touching temperatures or configurations
+ * @test ParallelTempering::temper()
+ * @test ParallelTempering::setMoveLimit()
+ * @test ParallelTempering::getBestBoard()
+ */
+TEST(SeededLadder, ParallelTempering){
+  std::string path = "../tests/test6.test";
+  Input input;
+  Board board = input.inputFromFile(path);
+  Board seed = TentMatcher(board).buildBoard();
+  const size_t replicas = 4;
+  const size_t moveLimit = ParallelTempering::MOVES_PER_EXCHANGE * 10;
+
+  auto runLadder = [&](ParallelTempering& tempering) {
+    tempering.setMoveLimit(moveLimit);
+    return tempering.temper();
+  };
+  ParallelTempering tempering(path.data(), seed, replicas, 0.05, 4.0, 0.0, 11);
+  size_t best = runLadder(tempering);
+
+  const Board& shared = tempering.getBestBoard();
+  EXPECT_EQ(shared.getViolations(), best);
+  EXPECT_LE(best, seed.getViolations());
+  std::string text;
+  formatSolution(shared, text);
+  Board scratch = board;
+  Verifier::Result result = Verifier(board).verifyText(text, scratch);
+  EXPECT_TRUE(result.valid) << result.error;
+  EXPECT_EQ(result.violations, best);
+  Board rebuilt(shared.getNumRows(), shared.getNumCols(), shared.getRowTentNum(), shared.getColTentNum(), shared.getBoard(), shared.getNumTrees());
+  EXPECT_EQ(rebuilt.getViolations(), best);
+
+  // The ladder itself never moves, swaps only permute which replica sits on which rung.
+  const std::vector<double>& ladder = tempering.getLadder();
+  ASSERT_EQ(ladder.size(), replicas);
+  EXPECT_DOUBLE_EQ(ladder.front(), 0.05);
+  EXPECT_DOUBLE_EQ(ladder.back(), 4.0);
+  EXPECT_TRUE(std::is_sorted(ladder.begin(), ladder.end()));
+  std::vector<size_t> onRung = tempering.getReplicaOnRung();
+  std::sort(onRung.begin(), onRung.end());
+  for (size_t i = 0; i < replicas; i++)
+    EXPECT_EQ(onRung[i], i);
+  EXPECT_GT(tempering.getExchangeAccepts(), 0);
+
+  // Every replica kept its own chain: exactly the budgeted moves, and a board consistent with its counters.
+  for (size_t i = 0; i < replicas; i++) {
+    Annealer& replica = tempering.getReplica(i);
+    EXPECT_EQ(replica.getMoveCount(), moveLimit);
+    const Board& own = replica.getBestBoard();
+    Board recount(own.getNumRows(), own.getNumCols(), own.getRowTentNum(), own.getColTentNum(), own.getBoard(), own.getNumTrees());
+    EXPECT_EQ(recount.getViolations(), replica.getBestViolations());
+    EXPECT_GE(replica.getBestViolations(), best);
+  }
+
+  ParallelTempering again(path.data(), seed, replicas, 0.05, 4.0, 0.0, 11);
+  EXPECT_EQ(runLadder(again), best);
+  EXPECT_EQ(again.getReplicaOnRung(), tempering.getReplicaOnRung());
+}
@@ -0,0 +1,134 @@
+#include "../main/board.h"
+#include "../main/input.h"
+#include "../main/verifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+/**
+ * @brief Batch verifier for output files, the native counterpart of "python autograder.py grade"
+ * Usage:
+ *   ./verify <input> <output or directory of .out files> [...]
+ *   ./verify --all <directory>   every <name>_output directory checked against <name>.test or <name>.txt
+ * Prints one line per output and exits non-zero if any output is invalid or claims the wrong count.
+ */
+
+namespace fs = std::filesystem;
+
+struct Job {
+    size_t input;       // Index into the loaded inputs
+    std::string output;
+};
+
+static void collectOutputs(const fs::path& path, size_t input, std::vector<Job>& jobs) {
+    if (!fs::is_directory(path)) {
+        jobs.push_back(Job{input, path.string()});
+        return;
+    }
+    std::vector<std::string> outputs;
+    for (const fs::directory_entry& entry : fs::directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".out")
+            outputs.push_back(entry.path().string());
+    }
+    std::sort(outputs.begin(), outputs.end());
+    for (std::string& output : outputs)
+        jobs.push_back(Job{input, std::move(output)});
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input> <output|directory> [...]" << std::endl;
+        std::cerr << "       " << argv[0] << " --all <directory>" << std::endl;
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Inputs are listed once, every job refers to its input by index.
+    std::vector<std::string> inputPaths;
+    std::vector<Job> jobs;
+    if (std::string(argv[1]) == "--all") {
+        std::vector<fs::path> outputDirs;
+        for (const fs::directory_entry& entry : fs::directory_iterator(argv[2])) {
+            std::string name = entry.path().filename().string();
+            if (entry.is_directory() && name.size() > 7 && name.compare(name.size() - 7, 7, "_output") == 0)
+                outputDirs.push_back(entry.path());
+        }
+        std::sort(outputDirs.begin(), outputDirs.end());
+        for (const fs::path& dir : outputDirs) {
+            std::string stem = dir.string().substr(0, dir.string().size() - 7);
+            for (const char* extension : {".test", ".txt"}) {
+                if (fs::exists(stem + extension)) {
+                    inputPaths.push_back(stem + extension);
+                    collectOutputs(dir, inputPaths.size() - 1, jobs);
+                    break;
+                }
+            }
+        }
+    } else {
+        inputPaths.push_back(argv[1]);
+        for (int i = 2; i < argc; i++)
+            collectOutputs(argv[i], 0, jobs);
+    }
+
+    std::vector<std::unique_ptr<Board>> inputs(inputPaths.size());
+    std::vector<std::string> inputErrors(inputPaths.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (size_t i = 0; i < inputPaths.size(); i++) {
+        try {
+            Input input;
+            inputs[i] = std::make_unique<Board>(input.inputFromFile(inputPaths[i]));
+        } catch (const std::exception& error) {
+            inputErrors[i] = error.what();
+        }
+    }
+
+    // One scratch board per thread, cloneFrom keeps its buffers between outputs of similar size.
+    std::vector<Verifier::Result> results(jobs.size());
+    #pragma omp parallel
+    {
+        std::unique_ptr<Board> scratch;
+        #pragma omp for schedule(dynamic, 4)
+        for (size_t j = 0; j < jobs.size(); j++) {
+            const Job& job = jobs[j];
+            if (!inputs[job.input]) {
+                results[j].error = "Input " + inputPaths[job.input] + " is invalid: " + inputErrors[job.input];
+                continue;
+            }
+            if (!scratch)
+                scratch = std::make_unique<Board>(*inputs[job.input]);
+            results[j] = Verifier(*inputs[job.input]).verify(job.output, *scratch);
+        }
+    }
+
+    size_t ok = 0, mismatched = 0, invalid = 0;
+    for (size_t j = 0; j < jobs.size(); j++) {
+        const Verifier::Result& result = results[j];
+        std::cout << jobs[j].output << ": ";
+        if (!result.valid) {
+            invalid++;
+            std::cout << "INVALID " << result.error;
+        } else if (!result.matches()) {
+            mismatched++;
+            std::cout << "MISMATCH claimed " << result.claimedViolations << ", computed " << result.violations;
+        } else {
+            ok++;
+            std::cout << "OK " << result.violations << " violations";
+        }
+        if (result.valid && result.claimedTents != static_cast<long long>(result.tents))
+            std::cout << " (claims " << result.claimedTents << " tents, lists " << result.tents << ")";
+        std::cout << '\n';
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << jobs.size() << " outputs: " << ok << " ok, " << mismatched << " mismatched, " << invalid << " invalid in "
+              << elapsed * 1000.0 << " ms" << std::endl;
+
+    return mismatched + invalid == 0 ? 0 : 1;
+}